@@ -0,0 +1,48 @@
+###########################################################
+#
+#   QOffice: Office UI framework for Qt
+#   Copyright (C) 2016-2017 Nicolas Kogler
+#   License: Lesser General Public License 3.0
+#
+###########################################################
+
+###########################################################
+#
+# QMAKE SETTINGS
+###########################################################
+CONFIG         +=       c++11
+
+qoffice_static {
+    DEFINES    +=       QOFFICE_STATIC
+}
+
+qoffice_notrace {
+    DEFINES    +=       QOFFICE_NO_TRACE
+}
+
+###########################################################
+#
+# QMAKE SETTINGS (windows)
+###########################################################
+win32 {
+    QMAKE_TARGET_COMPANY        =   Nicolas Kogler
+    QMAKE_TARGET_PRODUCT        =   QOffice
+    QMAKE_TARGET_DESCRIPTION    =   Office UI framework for Qt
+    QMAKE_TARGET_COPYRIGHT      =   Copyright (C) 2016-2017 Nicolas Kogler
+}
+
+###########################################################
+#
+# COMPILER SETTINGS
+###########################################################
+gcc {
+    QMAKE_LFLAGS        +=      -static-libgcc -static-libstdc++
+}
+
+###########################################################
+#
+# INCLUDE PATHS
+###########################################################
+INCLUDEPATH         +=      $$PWD/include \
+                            $$PWD/include/QOffice \
+                            $$PWD/include/QOffice/Widgets
@@ -9,80 +9,32 @@
 ###########################################################
 #
 # QMAKE SETTINGS
-###########################################################
-TARGET          =       QOffice
-TEMPLATE        =       lib
-QT             +=       widgets uiplugin designer uitools
-CONFIG         +=       plugin c++11
-DEFINES        +=       QOFFICE_BUILD
-
-###########################################################
 #
-# QMAKE SETTINGS (windows)
+# Applications only link against the runtime library.
+# The Qt Designer plugin is built on top of it and is
+# skipped if QOffice is built statically, i.e. by
+# running 'qmake CONFIG+=qoffice_static'. The tests link
+# against the runtime library and run with 'make check'.
 ###########################################################
-win32 {
-    QMAKE_TARGET_COMPANY        =   Nicolas Kogler
-    QMAKE_TARGET_PRODUCT        =   QOffice
-    QMAKE_TARGET_DESCRIPTION    =   Office UI framework for Qt
-    QMAKE_TARGET_COPYRIGHT      =   Copyright (C) 2016-2017 Nicolas Kogler
-}
+TEMPLATE        =       subdirs
+SUBDIRS        +=       library
 
-###########################################################
-#
-# COMPILER SETTINGS
-###########################################################
-gcc {
-    QMAKE_LFLAGS        +=      -static-libgcc -static-libstdc++
-}
+library.file            =   QOfficeLibrary.pro
+library.makefile        =   Makefile.Library
 
-###########################################################
-#
-# INCLUDE PATHS
-###########################################################
-INCLUDEPATH         +=      include \
-                            include/QOffice \
-                            include/QOffice/Widgets
+!qoffice_static {
+    SUBDIRS            +=   designer
+    designer.file       =   QOfficeDesigner.pro
+    designer.makefile   =   Makefile.Designer
+    designer.depends    =   library
+}
 
-###########################################################
-#
-# RESOURCES & MISCELLANEOUS
-###########################################################
-RESOURCES           +=      resources/qoffice_plugins.qrc \
-                            resources/qoffice_images.qrc
-DISTFILES           +=      resources/templates/class.txt \
-                            resources/templates/enum.txt \
-                            resources/templates/plugin.txt \
-                            resources/templates/plugin_src.txt \
-                            resources/templates/source.txt \
-                            resources/templates/widget.txt \
-                            resources/templates/widget_src.txt
+SUBDIRS            +=   tests
+tests.file              =   tests/tests.pro
+tests.depends           =   library
 
-###########################################################
-#
-# HEADER FILES
-###########################################################
-HEADERS             +=      include/QOffice/Config.hpp \
-                            include/QOffice/Interfaces/IOfficeWidget.hpp \
-                            include/QOffice/Design/OfficeAccents.hpp \
-                            include/QOffice/Design/Exceptions/InvalidAccentException.hpp \
-                            include/QOffice/Widgets/OfficeWidget.hpp \
-                            include/QOffice/Widgets/OfficeWindow.hpp \
-                            include/QOffice/Plugins/OfficeWidgetPlugin.hpp \
-                            include/QOffice/Plugins/OfficeWindowPlugin.hpp \
-                            include/QOffice/Plugins/OfficePluginCollection.hpp \
-                            include/QOffice/Widgets/Enums/OfficeWindowEnums.hpp \
-                            include/QOffice/Widgets/Constants/OfficeWindowConstants.hpp \
-                            include/QOffice/Design/OfficePalette.hpp
+!qoffice_static {
+    tests.depends      +=   designer
+}
 
-###########################################################
-#
-# SOURCE FILES
-###########################################################
-SOURCES             +=      src/Design/Exceptions/InvalidAccentException.cpp \
-                            src/Design/OfficeAccents.cpp \
-                            src/Widgets/OfficeWidget.cpp \
-                            src/Widgets/OfficeWindow.cpp \
-                            src/Plugins/OfficeWidgetPlugin.cpp \
-                            src/Plugins/OfficePluginCollection.cpp \
-                            src/Plugins/OfficeWindowPlugin.cpp \
-                            src/Design/OfficePalette.cpp
+OTHER_FILES        +=       QOffice.pri
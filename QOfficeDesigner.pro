@@ -0,0 +1,54 @@
+###########################################################
+#
+#   QOffice: Office UI framework for Qt
+#   Copyright (C) 2016-2017 Nicolas Kogler
+#   License: Lesser General Public License 3.0
+#
+###########################################################
+
+###########################################################
+#
+# QMAKE SETTINGS
+###########################################################
+TARGET          =       QOfficeDesigner
+TEMPLATE        =       lib
+QT             +=       widgets uiplugin designer
+CONFIG         +=       plugin
+
+include(QOffice.pri)
+
+###########################################################
+#
+# LIBRARIES
+###########################################################
+win32:CONFIG(release, debug|release) {
+    LIBS            +=      -L$$OUT_PWD/release
+} else:win32:CONFIG(debug, debug|release) {
+    LIBS            +=      -L$$OUT_PWD/debug
+} else {
+    LIBS            +=      -L$$OUT_PWD
+}
+
+LIBS                +=      -lQOffice
+
+###########################################################
+#
+# RESOURCES
+###########################################################
+RESOURCES           +=      resources/qoffice_plugins.qrc
+
+###########################################################
+#
+# HEADER FILES
+###########################################################
+HEADERS             +=      include/QOffice/Plugins/OfficeWidgetPlugin.hpp \
+                            include/QOffice/Plugins/OfficeWindowPlugin.hpp \
+                            include/QOffice/Plugins/OfficePluginCollection.hpp
+
+###########################################################
+#
+# SOURCE FILES
+###########################################################
+SOURCES             +=      src/Plugins/OfficeWidgetPlugin.cpp \
+                            src/Plugins/OfficePluginCollection.cpp \
+                            src/Plugins/OfficeWindowPlugin.cpp
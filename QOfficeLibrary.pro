@@ -0,0 +1,92 @@
+###########################################################
+#
+#   QOffice: Office UI framework for Qt
+#   Copyright (C) 2016-2017 Nicolas Kogler
+#   License: Lesser General Public License 3.0
+#
+###########################################################
+
+###########################################################
+#
+# QMAKE SETTINGS
+###########################################################
+TARGET          =       QOffice
+TEMPLATE        =       lib
+QT             +=       widgets
+DEFINES        +=       QOFFICE_BUILD
+
+include(QOffice.pri)
+
+qoffice_static {
+    CONFIG     +=       staticlib
+}
+
+###########################################################
+#
+# RESOURCES & MISCELLANEOUS
+###########################################################
+DISTFILES           +=      resources/templates/class.txt \
+                            resources/templates/enum.txt \
+                            resources/templates/plugin.txt \
+                            resources/templates/plugin_src.txt \
+                            resources/templates/source.txt \
+                            resources/templates/widget.txt \
+                            resources/templates/widget_src.txt
+
+###########################################################
+#
+# HEADER FILES
+###########################################################
+HEADERS             +=      include/QOffice/Config.hpp \
+                            include/QOffice/Interfaces/IOfficeWidget.hpp \
+                            include/QOffice/Interfaces/IOfficeAnimated.hpp \
+                            include/QOffice/Interfaces/IOfficeCache.hpp \
+                            include/QOffice/Design/OfficeAccents.hpp \
+                            include/QOffice/Design/Exceptions/InvalidAccentException.hpp \
+                            include/QOffice/Design/Exceptions/InvalidPaletteRoleException.hpp \
+                            include/QOffice/Widgets/OfficeWidget.hpp \
+                            include/QOffice/Widgets/OfficeWindow.hpp \
+                            include/QOffice/Widgets/OfficeResourceContext.hpp \
+                            include/QOffice/Widgets/OfficeWindowLayout.hpp \
+                            include/QOffice/Widgets/OfficeWindowPool.hpp \
+                            include/QOffice/Widgets/OfficeDialog.hpp \
+                            include/QOffice/Widgets/OfficeWarmup.hpp \
+                            include/QOffice/Widgets/Enums/OfficeWindowEnums.hpp \
+                            include/QOffice/Widgets/Constants/OfficeWindowConstants.hpp \
+                            include/QOffice/Design/OfficePalette.hpp \
+                            include/QOffice/Design/OfficeAnimationClock.hpp \
+                            include/QOffice/Design/OfficeIdleScheduler.hpp \
+                            include/QOffice/Design/OfficeStyle.hpp \
+                            include/QOffice/Design/OfficeGlyphs.hpp \
+                            include/QOffice/Diagnostics/OfficeMemory.hpp \
+                            include/QOffice/Diagnostics/OfficeStartupTrace.hpp \
+                            include/QOffice/Diagnostics/OfficeTrace.hpp \
+                            include/QOffice/Diagnostics/OfficeWatchdog.hpp \
+                            include/QOffice/Diagnostics/OfficeCounters.hpp \
+                            include/QOffice/Diagnostics/OfficeLatencyStats.hpp
+
+###########################################################
+#
+# SOURCE FILES
+###########################################################
+SOURCES             +=      src/Design/Exceptions/InvalidAccentException.cpp \
+                            src/Design/Exceptions/InvalidPaletteRoleException.cpp \
+                            src/Design/OfficeAccents.cpp \
+                            src/Widgets/OfficeWidget.cpp \
+                            src/Widgets/OfficeWindow.cpp \
+                            src/Widgets/OfficeResourceContext.cpp \
+                            src/Widgets/OfficeWindowLayout.cpp \
+                            src/Widgets/OfficeWindowPool.cpp \
+                            src/Widgets/OfficeDialog.cpp \
+                            src/Widgets/OfficeWarmup.cpp \
+                            src/Design/OfficePalette.cpp \
+                            src/Design/OfficeAnimationClock.cpp \
+                            src/Design/OfficeIdleScheduler.cpp \
+                            src/Design/OfficeStyle.cpp \
+                            src/Design/OfficeGlyphs.cpp \
+                            src/Diagnostics/OfficeMemory.cpp \
+                            src/Diagnostics/OfficeStartupTrace.cpp \
+                            src/Diagnostics/OfficeTrace.cpp \
+                            src/Diagnostics/OfficeWatchdog.cpp \
+                            src/Diagnostics/OfficeCounters.cpp \
+                            src/Diagnostics/OfficeLatencyStats.cpp
@@ -36,15 +36,19 @@
  * This macro either exports or imports dynamic symbols
  * or does nothing if <em>QOFFICE_STATIC</em> is defined.
  * It furthermore only exports symbols if <em>QOFFICE_BUILD</em>
- * is defined, i.e. this library is being built.
+ * is defined, i.e. this library is being built. Applications
+ * linking against a static build of QOffice must define
+ * <em>QOFFICE_STATIC</em>, too.
  *
  * @def QOFFICE_EXPORT
  *
  */
-#if !defined(QOFFICE_STATIC) && defined(QOFFICE_BUILD)
+#if defined(QOFFICE_STATIC)
+    #define QOFFICE_EXPORT
+#elif defined(QOFFICE_BUILD)
     #define QOFFICE_EXPORT Q_DECL_EXPORT
 #else
-    #define QOFFICE_EXPORT
+    #define QOFFICE_EXPORT Q_DECL_IMPORT
 #endif
 
 
@@ -74,6 +74,17 @@ public:
      */
     static const QColor darker(const QColor& accent);
 
+    /**
+     * Linearly interpolates between two accent colors.
+     *
+     * @param from Accent color at the beginning.
+     * @param to Accent color at the end.
+     * @param t Progress between 0.0 and 1.0.
+     * @returns the interpolated accent color.
+     *
+     */
+    static const QColor blend(const QColor& from, const QColor& to, qreal t);
+
     /**
      * Modifies the custom accent color. The predefined accent colors
      * can not be modified this way. If one desires to have multiple
@@ -0,0 +1,145 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICEANIMATIONCLOCK_HPP
+#define QOFFICE_OFFICEANIMATIONCLOCK_HPP
+
+
+// QOffice headers
+#include <QOffice/Interfaces/IOfficeAnimated.hpp>
+
+// Qt headers
+#include <QBasicTimer>
+#include <QElapsedTimer>
+#include <QObject>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+/**
+ * Drives all QOffice animations with one single timer.
+ * The timer only runs while at least one animation is
+ * attached, so an idle application never wakes up.
+ *
+ * @class OfficeAnimationClock
+ * @author Nicolas Kogler
+ * @date January 2nd, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeAnimationClock : public QObject
+{
+public:
+
+    /**
+     * Retrieves the clock shared by all QOffice widgets.
+     * Must only be used from within the GUI thread.
+     *
+     * @returns the global animation clock.
+     *
+     */
+    static OfficeAnimationClock* instance();
+
+
+    /**
+     * Retrieves the elapsed time of the clock.
+     *
+     * @returns the time in milliseconds.
+     *
+     */
+    qint64 time() const;
+
+    /**
+     * Determines whether the given animation is
+     * currently attached to the clock.
+     *
+     * @param animation Animation to look for.
+     * @returns true if it is attached.
+     *
+     */
+    bool isAttached(IOfficeAnimated* animation) const;
+
+    /**
+     * Attaches the given animation to the clock. It will
+     * be advanced every frame until it reports that it has
+     * finished or is detached manually.
+     *
+     * @param animation Animation to attach.
+     *
+     */
+    void attach(IOfficeAnimated* animation);
+
+    /**
+     * Detaches the given animation from the clock. Stops
+     * the timer if there are no animations left.
+     *
+     * @param animation Animation to detach.
+     *
+     */
+    void detach(IOfficeAnimated* animation);
+
+
+protected:
+
+    /**
+     * Advances all attached animations.
+     *
+     * @param event Holds the ID of the timer.
+     *
+     */
+    void timerEvent(QTimerEvent* event) override;
+
+
+private:
+
+    /**
+     * Initializes the one and only OfficeAnimationClock.
+     *
+     */
+    OfficeAnimationClock();
+
+    // Members
+    QBasicTimer             m_Timer;
+    QElapsedTimer           m_Elapsed;
+    QList<IOfficeAnimated*> m_Animations;
+
+    // Metadata
+    Q_OBJECT
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     OfficeAnimationClock::instance()->attach(this);
+ * @endcode
+ *
+ * @sa IOfficeAnimated
+ *
+ */
+
+#endif // QOFFICE_OFFICEANIMATIONCLOCK_HPP
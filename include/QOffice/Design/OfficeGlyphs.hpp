@@ -0,0 +1,119 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICEGLYPHS_HPP
+#define QOFFICE_OFFICEGLYPHS_HPP
+
+
+// QOffice headers
+#include <QOffice/Config.hpp>
+
+// Qt headers
+#include <QColor>
+#include <QImage>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+/**
+ * Provides the glyphs of the window buttons. They are
+ * defined as vector paths and rasterized only once per
+ * size, device pixel ratio and color. The rasterized
+ * glyphs are shared by all windows.
+ *
+ * @class OfficeGlyphs
+ * @author Nicolas Kogler
+ * @date January 7th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeGlyphs
+{
+public:
+
+    /**
+     * Holds all glyphs available in OfficeGlyphs.
+     *
+     * @enum Glyph
+     *
+     */
+    enum Glyph
+    {
+        Close,
+        Maximize,
+        Minimize,
+        Restore,
+        Max
+    };
+
+
+    /**
+     * Retrieves the given glyph rasterized for the given
+     * size, device pixel ratio and color. Rasterizes the
+     * glyph if it is not in the cache yet.
+     *
+     * @param glyph The glyph to retrieve.
+     * @param size The size of the glyph, in device independent pixels.
+     * @param dpr The device pixel ratio of the target screen.
+     * @param color The color to render the glyph in.
+     * @returns the rasterized glyph.
+     *
+     */
+    static QImage get(Glyph glyph, const QSize& size, qreal dpr, const QColor& color);
+
+    /**
+     * Rasterizes the given glyph without consulting the
+     * cache. Is reentrant and may therefore be called from
+     * any thread.
+     *
+     * @param glyph The glyph to rasterize.
+     * @param size The size of the glyph, in device independent pixels.
+     * @param dpr The device pixel ratio of the target screen.
+     * @param color The color to render the glyph in.
+     * @returns the rasterized glyph.
+     *
+     */
+    static QImage render(Glyph glyph, const QSize& size, qreal dpr, const QColor& color);
+
+    /**
+     * Removes all rasterized glyphs from the cache.
+     *
+     */
+    static void clear();
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     QImage img = OfficeGlyphs::get(OfficeGlyphs::Close, size, dpr, Qt::white);
+ *     painter.drawImage(QRect(pos, size), img);
+ * @endcode
+ *
+ */
+
+#endif // QOFFICE_OFFICEGLYPHS_HPP
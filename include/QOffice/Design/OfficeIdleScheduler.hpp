@@ -0,0 +1,239 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICEIDLESCHEDULER_HPP
+#define QOFFICE_OFFICEIDLESCHEDULER_HPP
+
+
+// QOffice headers
+#include <QOffice/Diagnostics/OfficeLatencyStats.hpp>
+
+// Qt headers
+#include <QBasicTimer>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QVector>
+
+// Standard headers
+#include <functional>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+/**
+ * Runs non-urgent QOffice work, e.g. warming or trimming
+ * caches, once the event loop has no other events left.
+ * Tasks are identified by their owner and name; scheduling
+ * a task that is still pending supersedes it. Each round
+ * runs tasks, highest priority first, until its time budget
+ * is used up. Like the animation clock, the timer only runs
+ * while tasks are pending.
+ *
+ * @class OfficeIdleScheduler
+ * @author Nicolas Kogler
+ * @date January 19th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeIdleScheduler : public QObject
+{
+public:
+
+    /**
+     * Holds the priority of a task.
+     *
+     * @enum Priority
+     *
+     */
+    enum Priority
+    {
+        High,
+        Normal,
+        Low,
+        PriorityCount
+    };
+
+    /**
+     * Holds the work of a task.
+     *
+     * @typedef Task
+     *
+     */
+    typedef std::function<void()> Task;
+
+
+    /**
+     * Retrieves the scheduler shared by all QOffice widgets.
+     * Must only be used from within the GUI thread.
+     *
+     * @returns the global idle scheduler.
+     *
+     */
+    static OfficeIdleScheduler* instance();
+
+
+    /**
+     * Retrieves the time a round of tasks may take.
+     *
+     * @returns the budget in milliseconds.
+     *
+     */
+    int frameBudget() const;
+
+    /**
+     * Retrieves the number of pending tasks.
+     *
+     * @returns the queue depth.
+     *
+     */
+    int pending() const;
+
+    /**
+     * Determines whether the given task is pending.
+     *
+     * @param owner The object the task belongs to.
+     * @param name The name of the task.
+     * @returns true if it is.
+     *
+     */
+    bool isScheduled(const void* owner, const char* name) const;
+
+    /**
+     * Retrieves the time between scheduling and running
+     * a task, for all tasks run so far.
+     *
+     * @returns the queue latency in nanoseconds.
+     *
+     */
+    const OfficeLatencyStats& latency() const;
+
+
+    /**
+     * Specifies the time a round of tasks may take. At
+     * least one task is run per round, regardless.
+     *
+     * @param msecs The budget in milliseconds.
+     *
+     */
+    void setFrameBudget(int msecs);
+
+    /**
+     * Schedules the given task. If a task with the same
+     * owner and name is still pending, it is replaced and
+     * keeps its place in the queue.
+     *
+     * @param owner The object the task belongs to.
+     * @param name The name of the task, must be a literal.
+     * @param priority The priority of the task.
+     * @param task The work to do.
+     *
+     */
+    void schedule(const void* owner, const char* name, Priority priority, Task task);
+
+    /**
+     * Removes the given task if it is still pending.
+     *
+     * @param owner The object the task belongs to.
+     * @param name The name of the task.
+     *
+     */
+    void cancel(const void* owner, const char* name);
+
+    /**
+     * Removes all pending tasks of the given owner. Must be
+     * called by owners that are destroyed before their tasks
+     * have run.
+     *
+     * @param owner The object the tasks belong to.
+     *
+     */
+    void cancelAll(const void* owner);
+
+
+protected:
+
+    /**
+     * Runs the pending tasks within the budget.
+     *
+     * @param event Holds the ID of the timer.
+     *
+     */
+    void timerEvent(QTimerEvent* event) override;
+
+
+private:
+
+    /**
+     * Holds a pending task.
+     *
+     */
+    struct Entry
+    {
+        const void* owner;
+        const char* name;
+        Task task;
+        qint64 queued;
+    };
+
+    /**
+     * Initializes the one and only OfficeIdleScheduler.
+     *
+     */
+    OfficeIdleScheduler();
+
+    // Helpers
+    auto find(const void* owner, const char* name) -> Entry*;
+    void updateTimer();
+
+    // Members
+    QVector<Entry>      m_Tasks[PriorityCount];
+    QBasicTimer         m_Timer;
+    QElapsedTimer       m_Clock;
+    OfficeLatencyStats  m_Latency;
+    int                 m_Budget;
+
+    // Metadata
+    Q_OBJECT
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     OfficeIdleScheduler::instance()->schedule(
+ *         this, "rebuildIcons", OfficeIdleScheduler::Low,
+ *         [this] () { rebuildIcons(); });
+ *
+ *     // Within the destructor.
+ *     OfficeIdleScheduler::instance()->cancelAll(this);
+ * @endcode
+ *
+ * @sa OfficeAnimationClock
+ *
+ */
+
+#endif // QOFFICE_OFFICEIDLESCHEDULER_HPP
@@ -25,17 +25,24 @@
 
 
 // QOffice headers
-#include <QOffice/Config.hpp>
+#include <QOffice/Interfaces/IOfficeWidget.hpp>
 
 // Qt headers
 #include <QColor>
+#include <QPalette>
+
+
+class QWidget;
 
 
 QOFFICE_BEGIN_NAMESPACE
 
 
 /**
- * Holds common color values used by QOffice.
+ * Holds common color values used by QOffice. Also provides
+ * a QPalette built from these colors, so that standard Qt
+ * widgets within QOffice windows can be themed without
+ * the use of style sheets.
  *
  * @class OfficePalette
  * @author Nicolas Kogler
@@ -57,6 +64,20 @@ public:
         Background,
         Foreground,
         DisabledText,
+        Base,
+        AlternateBase,
+        Text,
+        Button,
+        ButtonText,
+        BrightText,
+        Light,
+        Midlight,
+        Mid,
+        Dark,
+        Shadow,
+        HighlightedText,
+        ToolTipBase,
+        ToolTipText,
         Max
     };
 
@@ -72,11 +93,67 @@ public:
      */
     static const QColor& get(PaletteRole role);
 
+    /**
+     * Modifies the color of the given palette role. Starts a
+     * new theme epoch, i.e. all cached QPalettes are rebuilt
+     * the next time they are requested. OfficeWindow picks up
+     * the new palette the next time its accent is applied.
+     *
+     * @param role The role of the color to modify.
+     * @param color The new color of the role.
+     * @throws InvalidPaletteRoleException
+     *
+     */
+    static void set(PaletteRole role, const QColor& color);
+
+    /**
+     * Retrieves the current theme epoch. It is incremented
+     * every time a palette or an accent color is modified.
+     *
+     * @returns the current theme epoch.
+     *
+     */
+    static int epoch();
+
+    /**
+     * Starts a new theme epoch. Must be called whenever one
+     * of the colors used by the QPalette is modified.
+     *
+     */
+    static void invalidate();
+
+    /**
+     * Retrieves a QPalette that maps all palette roles and
+     * the given accent to the corresponding QPalette roles.
+     * The QPalette is built only once per theme epoch.
+     *
+     * @param accent The accent to use as highlight color.
+     * @returns the cached QPalette.
+     * @throws InvalidAccentException
+     *
+     */
+    static const QPalette& palette(IOfficeWidget::Accent accent);
+
+    /**
+     * Applies the cached QPalette to the given widget. Qt then
+     * propagates it to all children that have no palette of
+     * their own. Does nothing if the widget already uses the
+     * palette of the current theme epoch and the given accent.
+     *
+     * @param widget The widget, preferably a top-level one.
+     * @param accent The accent to use as highlight color.
+     *
+     */
+    static void apply(QWidget* widget, IOfficeWidget::Accent accent);
+
 
 private:
 
     // Static members
     static std::vector<QColor> g_Colors;
+    static std::vector<QPalette> g_Palettes;
+    static std::vector<int> g_PaletteEpochs;
+    static int g_Epoch;
 };
 
 
@@ -89,6 +166,7 @@ QOFFICE_END_NAMESPACE
  * Usage example:
  * @code
  *     const QColor& c = OfficePalette::get(PaletteRole::Background);
+ *     OfficePalette::apply(window, IOfficeWidget::Blue);
  * @endcode
  *
  * @sa OfficePalette::PaletteRole
@@ -0,0 +1,221 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICESTYLE_HPP
+#define QOFFICE_OFFICESTYLE_HPP
+
+
+// QOffice headers
+#include <QOffice/Interfaces/IOfficeCache.hpp>
+
+// Qt headers
+#include <QCache>
+#include <QPixmap>
+#include <QProxyStyle>
+
+// Standard headers
+#include <functional>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+/**
+ * Renders standard Qt controls (push buttons, line edits,
+ * scroll bars and combo boxes) in the office design. Every
+ * rendered primitive is cached by element, state, size and
+ * device pixel ratio, so that repeated controls are blits.
+ *
+ * @class OfficeStyle
+ * @author Nicolas Kogler
+ * @date January 5th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeStyle : public QProxyStyle, public IOfficeCache
+{
+public:
+
+    /**
+     * Initializes a new instance of OfficeStyle.
+     *
+     * @param base The style to fall back to. Uses the
+     *        native style of the platform if null.
+     *
+     */
+    explicit OfficeStyle(QStyle* base = nullptr);
+
+    /**
+     * Detaches the primitive cache from OfficeMemory.
+     *
+     */
+    ~OfficeStyle();
+
+
+    /**
+     * Retrieves the maximum size of the primitive cache.
+     *
+     * @returns the cache limit in kilobytes.
+     *
+     */
+    int cacheLimit() const;
+
+    /**
+     * Specifies the maximum size of the primitive cache.
+     * Least recently used primitives are removed first.
+     *
+     * @param limit New cache limit in kilobytes.
+     *
+     */
+    void setCacheLimit(int limit);
+
+    /**
+     * Removes all cached primitives.
+     *
+     */
+    void clearCache();
+
+
+    /**
+     * Renders push button bevels, line edit panels and
+     * suppresses the focus rectangle. Everything else is
+     * forwarded to the base style.
+     *
+     * @param element The primitive element to draw.
+     * @param option Holds the state and the rectangle.
+     * @param painter The painter to draw with.
+     * @param widget The widget that is painted, if any.
+     *
+     */
+    void drawPrimitive(
+            PrimitiveElement element,
+            const QStyleOption* option,
+            QPainter* painter,
+            const QWidget* widget = nullptr) const override;
+
+    /**
+     * Renders the scroll bar slider and groove. Everything
+     * else is forwarded to the base style.
+     *
+     * @param element The control element to draw.
+     * @param option Holds the state and the rectangle.
+     * @param painter The painter to draw with.
+     * @param widget The widget that is painted, if any.
+     *
+     */
+    void drawControl(
+            ControlElement element,
+            const QStyleOption* option,
+            QPainter* painter,
+            const QWidget* widget = nullptr) const override;
+
+    /**
+     * Renders the frame of non-editable combo boxes.
+     * Everything else is forwarded to the base style.
+     *
+     * @param control The complex control to draw.
+     * @param option Holds the state and the rectangle.
+     * @param painter The painter to draw with.
+     * @param widget The widget that is painted, if any.
+     *
+     */
+    void drawComplexControl(
+            ComplexControl control,
+            const QStyleOptionComplex* option,
+            QPainter* painter,
+            const QWidget* widget = nullptr) const override;
+
+    /**
+     * Enables hover events on all controls that change
+     * their appearance when being hovered.
+     *
+     * @param widget The widget to polish.
+     *
+     */
+    void polish(QWidget* widget) override;
+
+    using QProxyStyle::polish;
+
+    /**
+     * Reimplemented pure virtual function from IOfficeCache.
+     * Adds the size of the primitive cache to \p usage.
+     *
+     * @param usage The memory usage to add to.
+     *
+     */
+    void collectUsage(OfficeMemoryUsage& usage) const override;
+
+    /**
+     * Reimplemented pure virtual function from IOfficeCache.
+     * Retrieves the time the last primitive was rendered.
+     *
+     * @returns the time of the last access.
+     *
+     */
+    quint64 lastAccess() const override;
+
+    /**
+     * Reimplemented pure virtual function from IOfficeCache.
+     * Removes all cached primitives.
+     *
+     */
+    void evict() override;
+
+
+private:
+
+    // Type definitions
+    typedef std::function<void(QPainter*, const QRect&)> Renderer;
+
+    // Members
+    mutable QCache<QString, QPixmap> m_Cache;
+    mutable quint64 m_LastAccess;
+
+    // Helpers
+    void drawCached(
+            QPainter* painter,
+            const QStyleOption* option,
+            int element,
+            int state,
+            const QRect& rect,
+            const Renderer& render) const;
+
+    // Metadata
+    Q_OBJECT
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     QApplication::setStyle(new OfficeStyle);
+ * @endcode
+ *
+ * @sa OfficePalette
+ *
+ */
+
+#endif // QOFFICE_OFFICESTYLE_HPP
@@ -0,0 +1,211 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICECOUNTERS_HPP
+#define QOFFICE_OFFICECOUNTERS_HPP
+
+
+// QOffice headers
+#include <QOffice/Config.hpp>
+
+// Qt headers
+#include <QByteArray>
+#include <QJsonObject>
+#include <QList>
+
+// Standard headers
+#include <atomic>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+/**
+ * Holds a named value that is updated with relaxed atomics
+ * and registers itself in the global counter registry.
+ * Counters are meant to be defined as static variables.
+ *
+ * @class OfficeCounter
+ * @author Nicolas Kogler
+ * @date January 13th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeCounter
+{
+public:
+
+    /**
+     * Describes how the value is to be interpreted.
+     *
+     * @enum Kind
+     *
+     */
+    enum Kind
+    {
+        Counter,    ///< Monotonically increasing total
+        Gauge       ///< Current level that may decrease
+    };
+
+
+    /**
+     * Registers the counter under the given name.
+     *
+     * @param name The static, dot-separated name.
+     * @param kind The interpretation of the value.
+     *
+     */
+    OfficeCounter(const char* name, Kind kind = Counter);
+
+    /**
+     * Unregisters the counter.
+     *
+     */
+    ~OfficeCounter();
+
+
+    /**
+     * Retrieves the name of this counter.
+     *
+     * @returns the dot-separated name.
+     *
+     */
+    const char* name() const { return m_Name; }
+
+    /**
+     * Retrieves the interpretation of the value.
+     *
+     * @returns the kind of this counter.
+     *
+     */
+    Kind kind() const { return m_Kind; }
+
+    /**
+     * Retrieves the current value.
+     *
+     * @returns the value.
+     *
+     */
+    qint64 value() const { return m_Value.load(std::memory_order_relaxed); }
+
+
+    /**
+     * Adds the given amount to the value.
+     *
+     * @param amount The amount to add, may be negative.
+     *
+     */
+    void add(qint64 amount = 1) { m_Value.fetch_add(amount, std::memory_order_relaxed); }
+
+    /**
+     * Specifies the value.
+     *
+     * @param value The new value.
+     *
+     */
+    void set(qint64 value) { m_Value.store(value, std::memory_order_relaxed); }
+
+
+private:
+
+    Q_DISABLE_COPY(OfficeCounter)
+
+    // Members
+    const char* m_Name;
+    Kind m_Kind;
+    std::atomic<qint64> m_Value;
+};
+
+
+/**
+ * Provides access to all registered QOffice counters, e.g.
+ * for monitoring agents. Rates, such as paints per second,
+ * are derived by polling the monotonic counters.
+ *
+ * @class OfficeCounters
+ * @author Nicolas Kogler
+ * @date January 13th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeCounters
+{
+public:
+
+    /**
+     * Retrieves all registered counters.
+     *
+     * @returns a snapshot of the registry.
+     *
+     */
+    static QList<OfficeCounter*> all();
+
+    /**
+     * Retrieves the current value of the given counter.
+     *
+     * @param name The name of the counter.
+     * @returns the value, 0 if no such counter exists.
+     *
+     */
+    static qint64 value(const char* name);
+
+    /**
+     * Retrieves all counters as JSON object, grouped
+     * into "counters" and "gauges".
+     *
+     * @returns the JSON object.
+     *
+     */
+    static QJsonObject toJson();
+
+    /**
+     * Retrieves all counters as compact JSON document.
+     *
+     * @returns the UTF-8 encoded JSON document.
+     *
+     */
+    static QByteArray dump();
+
+    /**
+     * Resets all counters to zero. Gauges are left
+     * untouched, as they reflect a current level.
+     *
+     */
+    static void reset();
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     static OfficeCounter myCounter("app.reloads");
+ *     myCounter.add();
+ *
+ *     socket->write(OfficeCounters::dump());
+ * @endcode
+ *
+ */
+
+#endif // QOFFICE_OFFICECOUNTERS_HPP
@@ -0,0 +1,134 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICELATENCYSTATS_HPP
+#define QOFFICE_OFFICELATENCYSTATS_HPP
+
+
+// QOffice headers
+#include <QOffice/Config.hpp>
+
+// Qt headers
+#include <QVector>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+/**
+ * Collects a latency distribution in a log-linear histogram.
+ * Each power of two is split into 16 buckets, therefore the
+ * percentiles are accurate to about 6 percent, while the
+ * memory usage is constant regardless of the sample count.
+ *
+ * @class OfficeLatencyStats
+ * @author Nicolas Kogler
+ * @date January 14th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeLatencyStats
+{
+public:
+
+    /**
+     * Constructs an empty distribution.
+     *
+     */
+    OfficeLatencyStats();
+
+
+    /**
+     * Adds a sample to the distribution.
+     *
+     * @param nsecs The latency in nanoseconds.
+     *
+     */
+    void add(qint64 nsecs);
+
+    /**
+     * Removes all samples.
+     *
+     */
+    void clear();
+
+
+    /**
+     * Retrieves the number of samples.
+     *
+     * @returns the sample count.
+     *
+     */
+    quint64 count() const;
+
+    /**
+     * Retrieves the mean latency.
+     *
+     * @returns the mean in nanoseconds, 0 if empty.
+     *
+     */
+    qint64 mean() const;
+
+    /**
+     * Retrieves the largest latency.
+     *
+     * @returns the maximum in nanoseconds, 0 if empty.
+     *
+     */
+    qint64 max() const;
+
+    /**
+     * Retrieves the latency below which the given
+     * fraction of all samples lies.
+     *
+     * @param fraction The fraction, e.g. 0.99 for the p99.
+     * @returns the percentile in nanoseconds, 0 if empty.
+     *
+     */
+    qint64 percentile(qreal fraction) const;
+
+
+private:
+
+    // Members
+    QVector<quint64> m_Buckets;
+    quint64 m_Count;
+    qint64 m_Sum;
+    qint64 m_Max;
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     OfficeLatencyStats stats;
+ *     stats.add(timer.nsecsElapsed());
+ *     qint64 p99 = stats.percentile(0.99);
+ * @endcode
+ *
+ */
+
+#endif // QOFFICE_OFFICELATENCYSTATS_HPP
@@ -0,0 +1,187 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICEMEMORY_HPP
+#define QOFFICE_OFFICEMEMORY_HPP
+
+
+// QOffice headers
+#include <QOffice/Interfaces/IOfficeCache.hpp>
+
+// Qt headers
+#include <QList>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+/**
+ * Holds the number of bytes used by QOffice caches,
+ * broken down by category.
+ *
+ * @struct OfficeMemoryUsage
+ * @author Nicolas Kogler
+ * @date January 9th, 2017
+ *
+ */
+struct QOFFICE_EXPORT OfficeMemoryUsage
+{
+    qint64 shadows      = 0;    ///< Drop shadow tiles
+    qint64 glyphs       = 0;    ///< Rasterized window glyphs
+    qint64 titles       = 0;    ///< Visible and elided window titles
+    qint64 primitives   = 0;    ///< Cached OfficeStyle primitives
+    qint64 palettes     = 0;    ///< Cached QPalettes
+
+    /**
+     * Retrieves the sum of all categories.
+     *
+     * @returns the total number of bytes.
+     *
+     */
+    qint64 total() const;
+
+    /**
+     * Adds the bytes of all categories of \p other.
+     *
+     * @param other The memory usage to add.
+     * @returns a reference to this memory usage.
+     *
+     */
+    OfficeMemoryUsage& operator +=(const OfficeMemoryUsage& other);
+};
+
+
+/**
+ * Accounts for the memory used by all QOffice caches and
+ * enforces an optional memory budget. If the budget is
+ * exceeded, the least recently used caches are evicted.
+ * Must only be used from within the GUI thread.
+ *
+ * @class OfficeMemory
+ * @author Nicolas Kogler
+ * @date January 9th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeMemory
+{
+public:
+
+    /**
+     * Retrieves the memory used by all QOffice caches.
+     *
+     * @returns the global memory usage.
+     *
+     */
+    static OfficeMemoryUsage usage();
+
+    /**
+     * Retrieves the memory budget of QOffice.
+     *
+     * @returns the budget in bytes, 0 if unlimited.
+     *
+     */
+    static qint64 budget();
+
+    /**
+     * Specifies the memory budget of QOffice. Immediately
+     * evicts caches if the current usage exceeds it.
+     *
+     * @param bytes The new budget in bytes, 0 if unlimited.
+     *
+     */
+    static void setBudget(qint64 bytes);
+
+    /**
+     * Writes the global memory usage, broken down by
+     * category, to the 'qoffice.memory' logging category.
+     *
+     */
+    static void log();
+
+
+    /**
+     * Attaches the given cache to the memory accounting.
+     *
+     * @param cache The cache to attach.
+     *
+     */
+    static void attach(IOfficeCache* cache);
+
+    /**
+     * Detaches the given cache from the memory accounting.
+     *
+     * @param cache The cache to detach.
+     *
+     */
+    static void detach(IOfficeCache* cache);
+
+    /**
+     * Advances the access clock of the caches. Caches
+     * store the returned value whenever they are used.
+     *
+     * @returns the current access time.
+     *
+     */
+    static quint64 touch();
+
+    /**
+     * Must be called by a cache whenever it has grown.
+     * Once the event loop is idle, evicts caches, least
+     * recently used first, until the memory usage fits in
+     * the budget. The cache that has grown is used most
+     * recently and therefore evicted last.
+     *
+     * @param cache The cache that has grown.
+     *
+     */
+    static void commit(IOfficeCache* cache);
+
+
+private:
+
+    // Helpers
+    static void evict();
+
+    // Static members
+    static QList<IOfficeCache*> g_Caches;
+    static qint64 g_Budget;
+    static quint64 g_Clock;
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     OfficeMemory::setBudget(4 * 1024 * 1024);
+ *     qint64 total = OfficeMemory::usage().total();
+ * @endcode
+ *
+ * @sa IOfficeCache
+ *
+ */
+
+#endif // QOFFICE_OFFICEMEMORY_HPP
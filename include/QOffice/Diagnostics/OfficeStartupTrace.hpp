@@ -0,0 +1,121 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICESTARTUPTRACE_HPP
+#define QOFFICE_OFFICESTARTUPTRACE_HPP
+
+
+// QOffice headers
+#include <QOffice/Config.hpp>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+/**
+ * Records the points in time at which QOffice reaches the
+ * phases of an application startup, measured from the start
+ * of the process. If the environment variable
+ * <em>QOFFICE_STARTUP_TRACE</em> is set, all phases are written
+ * to the 'qoffice.startup' logging category after the first
+ * window has been painted.
+ *
+ * @class OfficeStartupTrace
+ * @author Nicolas Kogler
+ * @date January 10th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeStartupTrace
+{
+public:
+
+    /**
+     * Holds all startup phases in chronological order.
+     *
+     * @enum Phase
+     *
+     */
+    enum Phase
+    {
+        LibraryLoad,
+        ResourceContext,
+        FirstWindow,
+        FirstDropShadow,
+        FirstPaint,
+        Max
+    };
+
+
+    /**
+     * Records the given phase, unless it has already been
+     * reached before. Is cheap enough for hot paths and
+     * may be called from any thread.
+     *
+     * @param phase The phase that has been reached.
+     *
+     */
+    static void mark(Phase phase);
+
+    /**
+     * Retrieves the point in time the given phase has
+     * been reached, relative to the start of the process.
+     * Is relative to the library load instead if the start
+     * of the process cannot be determined on this platform.
+     *
+     * @param phase The phase to retrieve.
+     * @returns the time in microseconds, -1 if not reached.
+     *
+     */
+    static qint64 elapsed(Phase phase);
+
+    /**
+     * Retrieves the name of the given phase.
+     *
+     * @param phase The phase to retrieve the name of.
+     * @returns the name of the phase.
+     *
+     */
+    static const char* name(Phase phase);
+
+    /**
+     * Writes all phases that have been reached so far to
+     * the 'qoffice.startup' logging category.
+     *
+     */
+    static void dump();
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     qint64 us = OfficeStartupTrace::elapsed(OfficeStartupTrace::FirstPaint);
+ * @endcode
+ *
+ */
+
+#endif // QOFFICE_OFFICESTARTUPTRACE_HPP
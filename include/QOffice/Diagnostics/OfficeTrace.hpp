@@ -0,0 +1,182 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICETRACE_HPP
+#define QOFFICE_OFFICETRACE_HPP
+
+
+// QOffice headers
+#include <QOffice/Config.hpp>
+
+// Qt headers
+#include <QSize>
+#include <QString>
+
+// Forward declarations
+class QWidget;
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+// Forward declarations
+struct OfficeBreadcrumb;
+
+
+/**
+ * Writes the spans of QOffice operations as Chrome trace
+ * events, which can be opened in chrome://tracing or in
+ * Perfetto. Spans are queued in a lock-free ring buffer
+ * and written to the file by a background thread.
+ *
+ * @class OfficeTrace
+ * @author Nicolas Kogler
+ * @date January 11th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeTrace
+{
+public:
+
+    /**
+     * Starts tracing to the given file. Stops a
+     * trace that is currently running.
+     *
+     * @param path The path of the JSON file to write.
+     * @returns false if the file could not be opened.
+     *
+     */
+    static bool start(const QString& path);
+
+    /**
+     * Stops tracing, writes all pending spans
+     * and closes the file.
+     *
+     */
+    static void stop();
+
+    /**
+     * Determines whether tracing is running.
+     *
+     * @returns true if spans are being recorded.
+     *
+     */
+    static bool isEnabled();
+
+    /**
+     * Retrieves the number of spans that were dropped
+     * because the ring buffer was full.
+     *
+     * @returns the number of dropped spans.
+     *
+     */
+    static quint64 dropped();
+};
+
+
+/**
+ * Records the span of the scope it lives in, if tracing
+ * is enabled, and leaves a breadcrumb for the watchdog.
+ * Use the QOFFICE_TRACE_SCOPE macros instead of
+ * instantiating this class directly.
+ *
+ * @class OfficeTraceScope
+ * @author Nicolas Kogler
+ * @date January 11th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeTraceScope
+{
+public:
+
+    /**
+     * Begins the span of an operation on the given widget.
+     *
+     * @param name The static name of the operation.
+     * @param widget The widget the operation works on.
+     *
+     */
+    OfficeTraceScope(const char* name, const QWidget* widget);
+
+    /**
+     * Begins the span of an operation that does
+     * not belong to a specific widget.
+     *
+     * @param name The static name of the operation.
+     * @param size The size the operation works on.
+     *
+     */
+    OfficeTraceScope(const char* name, const QSize& size);
+
+    /**
+     * Ends the span and queues it for writing.
+     *
+     */
+    ~OfficeTraceScope();
+
+
+private:
+
+    Q_DISABLE_COPY(OfficeTraceScope)
+
+    // Helpers
+    void enter();
+
+    // Members
+    const char* m_Name;
+    quintptr m_Window;
+    QSize m_Size;
+    qint64 m_Begin;
+    OfficeBreadcrumb* m_Crumb;
+    const char* m_PrevName;
+    quintptr m_PrevWindow;
+    QSize m_PrevSize;
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+#define QOFFICE_TRACE_CONCAT_(a, b) a##b
+#define QOFFICE_TRACE_CONCAT(a, b) QOFFICE_TRACE_CONCAT_(a, b)
+
+#ifndef QOFFICE_NO_TRACE
+    #define QOFFICE_TRACE_SCOPE(name, target) \
+        off::OfficeTraceScope QOFFICE_TRACE_CONCAT(qofficeTrace, __LINE__)(name, target)
+#else
+    #define QOFFICE_TRACE_SCOPE(name, target)
+#endif
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     OfficeTrace::start("qoffice-trace.json");
+ *     ...
+ *     OfficeTrace::stop();
+ * @endcode
+ *
+ */
+
+#endif // QOFFICE_OFFICETRACE_HPP
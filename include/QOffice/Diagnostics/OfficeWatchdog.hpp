@@ -0,0 +1,128 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICEWATCHDOG_HPP
+#define QOFFICE_OFFICEWATCHDOG_HPP
+
+
+// QOffice headers
+#include <QOffice/Config.hpp>
+
+// Standard headers
+#include <atomic>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+/**
+ * Holds the QOffice operation a thread is currently in.
+ * Is updated by the QOFFICE_TRACE_SCOPE macros and read
+ * by the watchdog thread without any locking, therefore
+ * the fields might be inconsistent for a short moment.
+ *
+ * @struct OfficeBreadcrumb
+ * @author Nicolas Kogler
+ * @date January 12th, 2017
+ *
+ */
+struct QOFFICE_EXPORT OfficeBreadcrumb
+{
+    std::atomic<const char*> operation; ///< Static name of the operation
+    std::atomic<quintptr> window;       ///< Address of the window
+    std::atomic<int> width;             ///< Width of the window
+    std::atomic<int> height;            ///< Height of the window
+
+    /**
+     * Retrieves the breadcrumb of the calling thread.
+     *
+     * @returns the thread-local breadcrumb.
+     *
+     */
+    static OfficeBreadcrumb& current();
+};
+
+
+/**
+ * Detects stalls of the GUI event loop with a background
+ * thread. If the event loop does not return to waiting
+ * for events within the threshold, the QOffice operation
+ * in progress is written to the 'qoffice.watchdog'
+ * logging category.
+ *
+ * @class OfficeWatchdog
+ * @author Nicolas Kogler
+ * @date January 12th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeWatchdog
+{
+public:
+
+    /**
+     * Starts watching the event loop. Must be called from
+     * within the GUI thread after QApplication was created.
+     *
+     * @param threshold The stall threshold in milliseconds.
+     *
+     */
+    static void start(int threshold = 200);
+
+    /**
+     * Stops watching the event loop.
+     *
+     */
+    static void stop();
+
+    /**
+     * Determines whether the event loop is being watched.
+     *
+     * @returns true if the watchdog is running.
+     *
+     */
+    static bool isRunning();
+
+    /**
+     * Retrieves the number of stalls detected so far.
+     *
+     * @returns the number of stalls.
+     *
+     */
+    static quint64 stalls();
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     QApplication app(argc, argv);
+ *     OfficeWatchdog::start(250);
+ * @endcode
+ *
+ */
+
+#endif // QOFFICE_OFFICEWATCHDOG_HPP
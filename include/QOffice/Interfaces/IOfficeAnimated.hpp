@@ -0,0 +1,63 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_IOFFICEANIMATED_HPP
+#define QOFFICE_IOFFICEANIMATED_HPP
+
+
+// QOffice headers
+#include <QOffice/Config.hpp>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+/**
+ * Defines the interface for objects that are driven
+ * by the shared OfficeAnimationClock.
+ *
+ * @class IOfficeAnimated
+ * @author Nicolas Kogler
+ * @date January 2nd, 2017
+ *
+ */
+class QOFFICE_EXPORT IOfficeAnimated
+{
+public:
+
+    /**
+     * Advances the animation to the given point in time.
+     * Is called once per frame by OfficeAnimationClock
+     * as long as the object is attached to the clock.
+     *
+     * @param time Elapsed time of the clock, in milliseconds.
+     * @returns false if the animation has finished.
+     *
+     */
+    virtual bool advance(qint64 time) = 0;
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+#endif // QOFFICE_IOFFICEANIMATED_HPP
@@ -0,0 +1,82 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_IOFFICECACHE_HPP
+#define QOFFICE_IOFFICECACHE_HPP
+
+
+// QOffice headers
+#include <QOffice/Config.hpp>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+struct OfficeMemoryUsage;
+
+
+/**
+ * Defines the interface that should be inherited by
+ * every QOffice cache. Caches attach themselves to
+ * OfficeMemory, which accounts for their memory and
+ * evicts them if the memory budget is exceeded.
+ *
+ * @class IOfficeCache
+ * @author Nicolas Kogler
+ * @date January 9th, 2017
+ *
+ */
+class QOFFICE_EXPORT IOfficeCache
+{
+public:
+
+    /**
+     * Adds the number of bytes held by this cache to
+     * the corresponding categories of \p usage.
+     *
+     * @param usage The memory usage to add to.
+     *
+     */
+    virtual void collectUsage(OfficeMemoryUsage& usage) const = 0;
+
+    /**
+     * Retrieves the point in time this cache was used the
+     * last time, as returned by OfficeMemory::touch().
+     *
+     * @returns the time of the last access.
+     *
+     */
+    virtual quint64 lastAccess() const = 0;
+
+    /**
+     * Releases all the memory held by this cache. The
+     * cache must be able to rebuild its content later on.
+     *
+     */
+    virtual void evict() = 0;
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+#endif // QOFFICE_IOFFICECACHE_HPP
@@ -50,7 +50,7 @@ public:
 
     /**
      * Initializes a new instance of OfficePluginCollection.
-     * Adds an instance of all custom plugins to a list.
+     * The plugins themselves are created on first request.
      *
      * @param parent The qt designer as parent.
      *
@@ -58,7 +58,8 @@ public:
     OfficePluginCollection(QObject* parent = nullptr);
 
     /**
-     * Retrieves a list of all custom plugins.
+     * Retrieves a list of all custom plugins. Instantiates
+     * the plugins when being called for the first time.
      *
      * @returns all instantiated plugins.
      *
@@ -69,7 +70,7 @@ public:
 private:
 
     // Members
-    QList<QDesignerCustomWidgetInterface *> m_Plugins;
+    mutable QList<QDesignerCustomWidgetInterface *> m_Plugins;
 
     // Metadata
     Q_OBJECT
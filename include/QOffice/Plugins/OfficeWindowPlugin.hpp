@@ -29,6 +29,7 @@
 
 // Qt headers
 #include <QtUiPlugin/QDesignerCustomWidgetInterface>
+#include <QIcon>
 #include <QObject>
 
 
@@ -162,7 +163,9 @@ public:
 private:
 
     // Members
-    bool m_IsInitialized;
+    mutable QString m_DomXml;
+    mutable QIcon   m_Icon;
+    bool            m_IsInitialized;
 
     // Metadata
     Q_OBJECT
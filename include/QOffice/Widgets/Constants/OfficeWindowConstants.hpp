@@ -37,14 +37,20 @@ QOFFICE_BEGIN_NAMESPACE
 #define WINDOW_BUTTON_X     11  ///< Horizontal window button distance
 #define WINDOW_BUTTON_Y     9   ///< Vertical window button distance
 #define TITLE_HEIGHT        36  ///< Height of the title bar
+#define WINDOW_GLYPH_SIZE   10  ///< Size of the window button glyphs
 #define MENU_ITEM_SPACING   16  ///< Spacing between menu items
 #define MENU_ITEM_HEIGHT    16  ///< Height (font size) of the menu items
 #define MENU_ICON_Y         6   ///< Initial Y-position of the menu icons
+#define ACCENT_FADE_TIME    200 ///< Duration of an accent transition, in ms
+#define CAPTION_SPACING     8   ///< Spacing around caption widgets
 
 #define DROP_SHADOW_PADDING DROP_SHADOW * 2
 #define DROP_SHADOW_BLUR   -DROP_SHADOW / 4 + 1
+#define SHADOW_TILE_CORNER  (DROP_SHADOW_PADDING * 2)
 #define ICON_POSITION_X     WINDOW_BUTTON_X + DROP_SHADOW_PADDING
 #define ICON_POSITION_Y     WINDOW_BUTTON_Y + DROP_SHADOW_PADDING
+#define CAPTION_BTN_WIDTH   (WINDOW_GLYPH_SIZE + 20)
+#define CAPTION_BTN_HEIGHT  (WINDOW_GLYPH_SIZE + 16)
 
 #define RESIZE_TL           WinResizeDir::Top|WinResizeDir::Left
 #define RESIZE_TR           WinResizeDir::Top|WinResizeDir::Right
@@ -79,10 +79,72 @@ enum class WinResizeDir
     Bottom  = 0x0008
 };
 
+/**
+ * Holds the ids of the built-in caption items. The ids
+ * of custom caption items start at CaptionUser.
+ *
+ * @enum WinCaptionId
+ * @author Nicolas Kogler
+ * @date January 16th, 2017
+ *
+ */
+enum WinCaptionId
+{
+    CaptionClose,
+    CaptionMaximize,
+    CaptionMinimize,
+    CaptionUser
+};
+
 
 Q_DECLARE_FLAGS(WinResizeDirs, WinResizeDir)
+
+/**
+ * Holds the inputs the frame geometry of an OfficeWindow
+ * depends on. Only the parts of the frame that depend on
+ * a changed input are recomputed.
+ *
+ * @enum WinFrameInput
+ * @author Nicolas Kogler
+ * @date January 17th, 2017
+ *
+ */
+enum class WinFrameInput
+{
+    None        = 0x0000,
+    Size        = 0x0001,
+    Maximized   = 0x0002,
+    Caption     = 0x0004,
+    Resizable   = 0x0008,
+    Font        = 0x0010,
+    Title       = 0x0020
+};
+
+Q_DECLARE_FLAGS(WinFrameInputs, WinFrameInput)
+
+/**
+ * Holds the optional parts of an OfficeWindow frame. Parts
+ * that are left out are never constructed, which makes frames
+ * of fixed-size dialogs considerably cheaper.
+ *
+ * @enum WinFrameFeature
+ * @author Nicolas Kogler
+ * @date January 19th, 2017
+ *
+ */
+enum class WinFrameFeature
+{
+    None        = 0x0000,
+    Resizing    = 0x0001,
+    Maximizing  = 0x0002,
+    All         = Resizing | Maximizing
+};
+
+Q_DECLARE_FLAGS(WinFrameFeatures, WinFrameFeature)
 QOFFICE_END_NAMESPACE
 Q_DECLARE_OPERATORS_FOR_FLAGS(off::WinResizeDirs)
+Q_DECLARE_OPERATORS_FOR_FLAGS(off::WinFrameInputs)
+Q_DECLARE_OPERATORS_FOR_FLAGS(off::WinFrameFeatures)
 
 
 #endif // QOFFICE_OFFICEWINDOWENUMS_HPP
@@ -0,0 +1,82 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICEDIALOG_HPP
+#define QOFFICE_OFFICEDIALOG_HPP
+
+
+// QOffice headers
+#include <QOffice/Widgets/OfficeWindow.hpp>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+/**
+ * Fixed-size variant of OfficeWindow for dialogs. Shares the
+ * rendering of the frame, but never constructs the resizing
+ * areas or the maximize button, and can neither be resized
+ * nor maximized by the user.
+ *
+ * @class OfficeDialog
+ * @author Nicolas Kogler
+ * @date January 19th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeDialog : public OfficeWindow
+{
+public:
+
+    /**
+     * Initializes a new instance of OfficeDialog.
+     *
+     * @param parent The window this dialog belongs to.
+     *
+     */
+    OfficeDialog(QWidget* parent = nullptr);
+
+
+private:
+
+    // Metadata
+    Q_OBJECT
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     OfficeDialog* dialog = new OfficeDialog(window);
+ *     dialog->setWindowTitle("Settings");
+ *     dialog->setWindowModality(Qt::WindowModal);
+ *     dialog->setLayout(new OfficeWindowLayout);
+ *     dialog->show();
+ * @endcode
+ *
+ */
+
+#endif // QOFFICE_OFFICEDIALOG_HPP
@@ -0,0 +1,207 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICERESOURCECONTEXT_HPP
+#define QOFFICE_OFFICERESOURCECONTEXT_HPP
+
+
+// QOffice headers
+#include <QOffice/Design/OfficeGlyphs.hpp>
+#include <QOffice/Interfaces/IOfficeCache.hpp>
+
+// Qt headers
+#include <QImage>
+#include <QSharedPointer>
+#include <QTextOption>
+
+
+class QPainter;
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+/**
+ * Holds all immutable frame assets that are shared by the
+ * OfficeWindow instances on screens with the same device
+ * pixel ratio: the title text options, the window glyphs
+ * and a small drop shadow tile that is stretched to the
+ * size of each window. A context lives as long as at
+ * least one window references it. Its assets are
+ * rebuilt on demand after being evicted by OfficeMemory.
+ *
+ * @class OfficeResourceContext
+ * @author Nicolas Kogler
+ * @date January 8th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeResourceContext : public IOfficeCache
+{
+public:
+
+    /**
+     * Retrieves the context for screens with the given
+     * device pixel ratio. Creates it if it does not exist.
+     * Must only be used from within the GUI thread.
+     *
+     * @param dpr The device pixel ratio of the screen.
+     * @returns the shared resource context.
+     *
+     */
+    static QSharedPointer<OfficeResourceContext> acquire(qreal dpr);
+
+    /**
+     * Detaches this context from OfficeMemory.
+     *
+     */
+    ~OfficeResourceContext();
+
+    /**
+     * Renders the 9-patch drop shadow tile for the given
+     * device pixel ratio. Is reentrant and may therefore
+     * be called from any thread.
+     *
+     * @param dpr The device pixel ratio of the tile.
+     * @returns the drop shadow tile.
+     *
+     */
+    static QImage renderDropShadow(qreal dpr);
+
+
+    /**
+     * Retrieves the device pixel ratio of this context.
+     *
+     * @returns the device pixel ratio.
+     *
+     */
+    qreal devicePixelRatio() const;
+
+    /**
+     * Retrieves the options used to render window titles.
+     *
+     * @returns the title text options.
+     *
+     */
+    const QTextOption& titleOptions() const;
+
+    /**
+     * Retrieves the given window button glyph in the
+     * background color of the current OfficePalette.
+     *
+     * @param glyph The glyph to retrieve.
+     * @returns the rasterized glyph.
+     *
+     */
+    const QImage& glyph(OfficeGlyphs::Glyph glyph) const;
+
+    /**
+     * Retrieves the drop shadow tile. Generates it when
+     * it is requested for the first time.
+     *
+     * @returns the drop shadow tile.
+     *
+     */
+    const QImage& dropShadow() const;
+
+    /**
+     * Renders the drop shadow of a window by stretching
+     * the edges of the drop shadow tile. The corners shrink
+     * to half the size of windows smaller than two corners.
+     *
+     * Unlike the shadow rendered by QGraphicsDropShadowEffect
+     * in earlier versions, the shadow is centered below the
+     * window instead of offset by DROP_SHADOW_BLUR, and the
+     * unblurred window shape is not painted on top of it.
+     * The client area covers the shadow beneath it anyway.
+     *
+     * @param painter The painter to draw with.
+     * @param rect The rectangle of the entire window.
+     *
+     */
+    void drawDropShadow(QPainter* painter, const QRect& rect) const;
+
+    /**
+     * Reimplemented pure virtual function from IOfficeCache.
+     * Adds the size of the drop shadow tile to \p usage. The
+     * glyphs are shared with and accounted by OfficeGlyphs.
+     *
+     * @param usage The memory usage to add to.
+     *
+     */
+    void collectUsage(OfficeMemoryUsage& usage) const override;
+
+    /**
+     * Reimplemented pure virtual function from IOfficeCache.
+     * Retrieves the time the assets were used the last time.
+     *
+     * @returns the time of the last access.
+     *
+     */
+    quint64 lastAccess() const override;
+
+    /**
+     * Reimplemented pure virtual function from IOfficeCache.
+     * Releases the drop shadow tile and the glyphs.
+     *
+     */
+    void evict() override;
+
+
+private:
+
+    /**
+     * Initializes a new resource context for the
+     * given device pixel ratio.
+     *
+     */
+    explicit OfficeResourceContext(qreal dpr);
+
+    // Members
+    qreal          m_Dpr;
+    QTextOption    m_TitleOptions;
+    mutable QImage m_Glyphs[OfficeGlyphs::Max];
+    mutable int    m_GlyphEpoch;
+    mutable QImage m_DropShadow;
+    mutable quint64 m_LastAccess;
+
+    // Helpers
+    void generateDropShadow() const;
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     auto context = OfficeResourceContext::acquire(devicePixelRatioF());
+ *     context->drawDropShadow(&painter, rect());
+ * @endcode
+ *
+ * @sa OfficeWindow
+ *
+ */
+
+#endif // QOFFICE_OFFICERESOURCECONTEXT_HPP
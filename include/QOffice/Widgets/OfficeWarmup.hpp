@@ -0,0 +1,133 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICEWARMUP_HPP
+#define QOFFICE_OFFICEWARMUP_HPP
+
+
+// QOffice headers
+#include <QOffice/Design/OfficeGlyphs.hpp>
+
+// Qt headers
+#include <QColor>
+#include <QImage>
+#include <QList>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+/**
+ * Renders the frame assets of OfficeWindow on a worker
+ * thread, e.g. while a splash screen is visible. The first
+ * window of each screen then adopts the prepared assets
+ * instead of rendering them on the GUI thread.
+ *
+ * Only QImage-based assets are prepared: QFont caches are
+ * local to each thread and QPalettes are cheap to build,
+ * so neither would benefit from being prepared elsewhere.
+ *
+ * Assets that no window adopts count towards the memory
+ * budget of OfficeMemory and are evicted first. The worker
+ * is waited for once the application is destroyed.
+ *
+ * @class OfficeWarmup
+ * @author Nicolas Kogler
+ * @date January 19th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeWarmup
+{
+public:
+
+    /**
+     * Starts rendering the assets for the given device pixel
+     * ratios. Must be called from within the GUI thread after
+     * QApplication was created. Does nothing while running.
+     *
+     * @param dprs The device pixel ratios, empty for all screens.
+     *
+     */
+    static void start(const QList<qreal>& dprs = QList<qreal>());
+
+    /**
+     * Determines whether assets are still being rendered.
+     *
+     * @returns true if the worker is running.
+     *
+     */
+    static bool isRunning();
+
+    /**
+     * Blocks until all assets have been rendered.
+     *
+     * @param msecs The maximum time to wait, -1 for no limit.
+     * @returns false if the time limit was exceeded.
+     *
+     */
+    static bool wait(int msecs = -1);
+
+
+    /**
+     * Hands out the prepared drop shadow tile for the given
+     * device pixel ratio. Each tile is only handed out once.
+     *
+     * @param dpr The device pixel ratio of the tile.
+     * @returns the tile, or a null image if not prepared.
+     *
+     */
+    static QImage takeDropShadow(qreal dpr);
+
+    /**
+     * Hands out the prepared glyph for the given device pixel
+     * ratio and color. Each glyph is only handed out once.
+     *
+     * @param glyph The glyph to retrieve.
+     * @param dpr The device pixel ratio of the glyph.
+     * @param color The color of the glyph.
+     * @returns the glyph, or a null image if not prepared.
+     *
+     */
+    static QImage takeGlyph(OfficeGlyphs::Glyph glyph, qreal dpr, const QColor& color);
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     QApplication app(argc, argv);
+ *     splash.show();
+ *
+ *     OfficeWarmup::start();
+ *     loadDocuments();
+ *
+ *     window.show();
+ * @endcode
+ *
+ */
+
+#endif // QOFFICE_OFFICEWARMUP_HPP
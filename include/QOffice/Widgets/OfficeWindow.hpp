@@ -26,19 +26,64 @@
 
 // QOffice headers
 #include <QOffice/Interfaces/IOfficeWidget.hpp>
+#include <QOffice/Interfaces/IOfficeAnimated.hpp>
+#include <QOffice/Diagnostics/OfficeMemory.hpp>
 #include <QOffice/Widgets/Enums/OfficeWindowEnums.hpp>
 
 // Qt headers
+#include <QImage>
 #include <QMainWindow>
-#include <QTextOption>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QVector>
 
 
 QOFFICE_BEGIN_NAMESPACE
 
 
+class OfficeResourceContext;
+class WinCaptionTracker;
 class WinResizeArea;
 
 
+/**
+ * Holds a single item of the caption bar, which is either
+ * a button or an embedded widget. Items are laid out from
+ * the right to the left in the order they were added.
+ *
+ * @struct WinCaptionItem
+ * @author Nicolas Kogler
+ * @date January 16th, 2017
+ *
+ */
+struct WinCaptionItem
+{
+    int id;                     ///< The id of the item
+    bool visible;               ///< Whether the item is shown
+    bool embedded;              ///< Whether the item is a widget
+    QImage icon;                ///< The icon of a custom button
+    QPointer<QWidget> widget;   ///< The embedded widget, if any
+    QRect rect;                 ///< The area occupied by the item
+};
+
+
+/**
+ * Holds the interaction state of a window frame, e.g. for
+ * diagnostics and automated tests.
+ *
+ * @struct WinFrameState
+ * @author Nicolas Kogler
+ * @date January 19th, 2017
+ *
+ */
+struct WinFrameState
+{
+    int hotItem;                ///< Id of the active caption item, -1 if none
+    WinButtonState hotState;    ///< The state of the active caption item
+    WindowState interaction;    ///< Whether the window is dragged or resized
+};
+
+
 /**
  * This is the description of the class.
  *
@@ -47,7 +92,9 @@ class WinResizeArea;
  * @date December 24th, 2016
  *
  */
-class QOFFICE_EXPORT OfficeWindow : public QWidget, public IOfficeWidget
+class QOFFICE_EXPORT OfficeWindow : public QWidget,
+                                    public IOfficeWidget,
+                                    public IOfficeAnimated
 {
 public:
 
@@ -69,6 +116,13 @@ public:
      */
     OfficeWindow(QWidget* parent = nullptr);
 
+    /**
+     * Detaches a running accent transition from the
+     * shared animation clock.
+     *
+     */
+    ~OfficeWindow();
+
 
     /**
      * Reimplemented pure virtual function from IOfficeWidget.
@@ -110,6 +164,37 @@ public:
      */
     bool hasMinimizeButton() const;
 
+    /**
+     * Determines whether the given caption item is visible.
+     *
+     * @param id The id of the caption item.
+     * @returns true if it is.
+     */
+    bool isCaptionItemVisible(int id) const;
+
+    /**
+     * Retrieves the ids of all custom caption items in
+     * the order they were added.
+     *
+     * @returns the ids of the custom caption items.
+     */
+    QList<int> captionItems() const;
+
+    /**
+     * Retrieves the widget embedded as the given caption item.
+     *
+     * @param id The id of the caption item.
+     * @returns the widget, nullptr if the item is a button.
+     */
+    QWidget* captionWidget(int id) const;
+
+    /**
+     * Retrieves the interaction state of the frame.
+     *
+     * @returns the active caption item and interaction.
+     */
+    WinFrameState frameState() const;
+
     /**
      * Determines whether this window is resizable.
      *
@@ -117,6 +202,30 @@ public:
      */
     bool canResize() const;
 
+    /**
+     * Retrieves the optional parts this window was built with.
+     *
+     * @returns the frame features.
+     */
+    WinFrameFeatures frameFeatures() const;
+
+    /**
+     * Determines whether accent changes are animated.
+     *
+     * @returns true if they are.
+     */
+    bool isAccentAnimated() const;
+
+    /**
+     * Retrieves the number of bytes held by this window,
+     * broken down by category. Assets that are shared with
+     * other windows are accounted in each of them.
+     *
+     * @returns the memory usage of this window.
+     *
+     */
+    OfficeMemoryUsage memoryUsage() const;
+
 
    /**
     * Reimplmented pure virtual function from IOfficeWidget.
@@ -167,17 +276,90 @@ public:
      */
     void setMinimizeButtonVisible(bool minimize);
 
+    /**
+     * Shows or hides the given caption item.
+     *
+     * @param id The id of the caption item.
+     * @param visible True if the item should be shown.
+     *
+     */
+    void setCaptionItemVisible(int id, bool visible);
+
+    /**
+     * Adds a button to the left of all caption items.
+     * Emits captionButtonClicked() when it is clicked.
+     *
+     * @param icon The icon of the button.
+     * @returns the id of the new caption item.
+     *
+     */
+    int addCaptionButton(const QImage& icon);
+
+    /**
+     * Embeds a widget, e.g. a search box, to the left of
+     * all caption items. The window takes ownership of it
+     * and lays out its caption again whenever the size hint
+     * of the widget changes.
+     *
+     * @param widget The widget to embed.
+     * @returns the id of the new caption item, or -1 if
+     *          the widget is null.
+     *
+     */
+    int addCaptionWidget(QWidget* widget);
+
+    /**
+     * Removes the given custom caption item. Embedded
+     * widgets are handed back to the caller unparented.
+     *
+     * @param id The id of the caption item.
+     *
+     */
+    void removeCaptionItem(int id);
+
+    /**
+     * Removes all custom caption items, except for the given
+     * ones, and deletes the embedded widgets among them.
+     *
+     * @param keep The ids of the caption items to keep.
+     *
+     */
+    void clearCaptionItems(const QList<int>& keep = QList<int>());
+
     /**
      * Defines that the window can either be resized or not.
+     * Windows built without WinFrameFeature::Resizing can
+     * never be resized.
      *
      * @param resize True if able to resize.
      *
      */
     void setResizable(bool resize);
 
+    /**
+     * Defines whether accent changes fade from the old to
+     * the new accent color. Only the regions of the window
+     * that are painted in the accent color are repainted
+     * during the transition.
+     *
+     * @param animated True if accent changes are animated.
+     *
+     */
+    void setAccentAnimated(bool animated);
+
 
 protected:
 
+    /**
+     * Initializes a new instance of OfficeWindow that only
+     * constructs the given optional parts of the frame.
+     *
+     * @param features The optional parts of the frame.
+     * @param parent The parent of this widget.
+     *
+     */
+    OfficeWindow(WinFrameFeatures features, QWidget* parent);
+
     /**
      * Renders the office window. It has the typical stripe
      * at the top of the window (colored in the accent color).
@@ -191,7 +373,7 @@ protected:
 
     /**
      * Updates the positions of the window buttons, the menu,
-     * the title and other buttons. Pre-renders the drop shadow.
+     * the title and other buttons.
      *
      * @param event Holds the old widget size.
      *
@@ -245,13 +427,78 @@ protected:
      */
     virtual void showEvent(QShowEvent* event) override;
 
+    /**
+     * Reimplemented pure virtual function from IOfficeAnimated.
+     * Advances the accent transition and repaints the regions
+     * of the window that use the accent color.
+     *
+     * @param time Elapsed time of the animation clock.
+     * @returns false if the transition has finished.
+     *
+     */
+    bool advance(qint64 time) override;
+
+    /**
+     * Removes the hover highlight from the caption
+     * items once the mouse pointer leaves the window.
+     *
+     * @param event Holds nothing we need.
+     *
+     */
+    virtual void leaveEvent(QEvent* event) override;
+
+    /**
+     * Updates the frame if the window has been maximized or
+     * restored, or if its font or title has changed.
+     *
+     * @param event Holds the type of the change.
+     *
+     */
+    virtual void changeEvent(QEvent* event) override;
+
+    /**
+     * Lays out the caption items again once the size hint of
+     * an embedded widget has changed. Qt requests the layout
+     * of the window in that case.
+     *
+     * @param event The event to handle.
+     * @returns true if the event was recognized.
+     *
+     */
+    virtual bool event(QEvent* event) override;
+
+    /**
+     * Lays out the caption items again once an embedded
+     * widget with a layout of its own requests a new one.
+     *
+     * @param watched The object that received the event.
+     * @param event Holds the type of the event.
+     * @returns false, the event is never filtered out.
+     *
+     */
+    virtual bool eventFilter(QObject* watched, QEvent* event) override;
+
+
+signals:
+
+    /**
+     * Is emitted when a custom caption button was clicked.
+     *
+     * @param id The id of the clicked caption item.
+     *
+     */
+    void captionButtonClicked(int id);
+
 
 private:
 
     // Members
-    WinButtonState m_CloseState;
-    WinButtonState m_MaximState;
-    WinButtonState m_MinimState;
+    QVector<WinCaptionItem> m_CaptionItems;
+    QVector<qint16> m_CaptionLookup;
+    QRect          m_CaptionBand;
+    int            m_CaptionHot;
+    int            m_NextCaptionId;
+    WinButtonState m_CaptionState;
     WindowState    m_State;
     WinResizeArea* m_ResizeTopLeft;
     WinResizeArea* m_ResizeTopRight;
@@ -261,46 +508,51 @@ private:
     WinResizeArea* m_ResizeLeft;
     WinResizeArea* m_ResizeBottom;
     WinResizeArea* m_ResizeRight;
-    QPixmap        m_DropShadow;
-    QPixmap        m_CloseImage;
-    QPixmap        m_MaximImage;
-    QPixmap        m_MinimImage;
-    QPixmap        m_RestoreImage;
-    QTextOption    m_TitleOptions;
+    WinCaptionTracker* m_CaptionTracker;
+    QSharedPointer<OfficeResourceContext> m_Resources;
     QString        m_VisibleTitle;
     QPoint         m_InitialDragPos;
     QRect          m_ClientRect;
     QRect          m_TitleRect;
     QRect          m_DragRect;
-    QRect          m_CloseRect;
-    QRect          m_MaximRect;
-    QRect          m_MinimRect;
-    bool           m_HasCloseBtn;
-    bool           m_HasMaximBtn;
-    bool           m_HasMinimBtn;
+    WinFrameFeatures m_Features;
+    QColor         m_AccentFrom;
+    qint64         m_AccentStart;
     bool           m_CanResize;
+    bool           m_AccentAnimated;
+    bool           m_TitleDirty;
 
     // Helpers
-    void generateDropShadow();
     void repaintTitleBar();
-    void updateButtonRects();
+    void repaintAccent();
+    auto currentAccent() const -> QColor;
+    void updateFrame(WinFrameInputs changed);
+    void updateFrameRects();
+    void updateCaptionItems();
+    void updateCaptionHints();
     void updateResizeRects();
     void updateVisibleTitle();
+    void invalidateTitle();
+    auto titleTextBounds(int textWidth) const -> QRect;
     void updateResizeWidgets();
     void updateLayoutPadding();
-    auto centerRect(const QPixmap& img, const QRect& rc) -> QRect;
+    auto centerRect(const QSize& img, const QRect& rc) -> QRect;
     bool mouseMoveDrag(const QPoint& p);
-    bool mouseMoveSpecial(const QPoint& p);
-    bool mouseMoveHitTest(const QPoint& p);
+    void mouseMoveCaption(const QPoint& p);
     bool mousePressDrag(const QPoint& p);
-    bool mousePressHitTest(const QPoint& p);
+    void mousePressCaption(const QPoint& p);
     bool mouseReleaseDrag(const QPoint& p);
-    bool mouseReleaseAction(const QPoint& p);
+    void mouseReleaseCaption(const QPoint& p);
+    void triggerCaptionItem(int index);
+    void setCaptionHot(int index, WinButtonState state);
+    int  captionHitTest(const QPoint& p) const;
+    int  captionIndex(int id) const;
 
     // Metadata
     Q_OBJECT
     Q_ENUMS(AccentColor)
     Q_PROPERTY(bool CanResize READ canResize WRITE setResizable)
+    Q_PROPERTY(bool AccentAnimated READ isAccentAnimated WRITE setAccentAnimated)
     Q_PROPERTY(bool HasCloseButton READ hasCloseButton WRITE setCloseButtonVisible)
     Q_PROPERTY(bool HasMaximizeButton READ hasMaximizeButton WRITE setMaximizeButtonVisible)
     Q_PROPERTY(bool HasMinimizeButton READ hasMinimizeButton WRITE setMinimizeButtonVisible)
@@ -308,6 +560,7 @@ private:
 
     // Friends
     friend class WinResizeArea;
+    friend class WinCaptionTracker;
 };
 
 
@@ -381,6 +634,83 @@ private:
 };
 
 
+/**
+ * This class covers the caption buttons of the window.
+ * It is the only part of the window that tracks the mouse,
+ * so pointer movements over the rest of the window, e.g.
+ * the client area, never reach the caption hit-testing.
+ * Lies beneath all other children of the window.
+ *
+ * @class WinCaptionTracker
+ * @author Nicolas Kogler
+ * @date January 19th, 2017
+ *
+ */
+class WinCaptionTracker : public QWidget
+{
+public:
+
+    /**
+     * Stores a reference to the window and enables
+     * mouse tracking for this widget only.
+     *
+     * @param window Window owning this tracker.
+     *
+     */
+    WinCaptionTracker(OfficeWindow* window);
+
+
+protected:
+
+    /**
+     * Updates the hover state of the caption buttons.
+     *
+     * @param event Holds the current mouse position.
+     *
+     */
+    void mouseMoveEvent(QMouseEvent* event) override;
+
+    /**
+     * Presses the caption button below the mouse pointer.
+     *
+     * @param event Holds the mouse position and pressed button.
+     *
+     */
+    void mousePressEvent(QMouseEvent* event) override;
+
+    /**
+     * Triggers the caption button that has been pressed.
+     *
+     * @param event Holds the mouse position and released button.
+     *
+     */
+    void mouseReleaseEvent(QMouseEvent* event) override;
+
+    /**
+     * Swallows double clicks, so that the second click of
+     * a double click does not trigger a button again.
+     *
+     * @param event Holds nothing we need.
+     *
+     */
+    void mouseDoubleClickEvent(QMouseEvent* event) override;
+
+    /**
+     * Removes the hover highlight from the caption buttons.
+     *
+     * @param event Holds nothing we need.
+     *
+     */
+    void leaveEvent(QEvent* event) override;
+
+
+private:
+
+    // Members
+    OfficeWindow* m_Window;
+};
+
+
 QOFFICE_END_NAMESPACE
 
 
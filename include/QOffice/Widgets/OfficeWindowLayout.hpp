@@ -0,0 +1,208 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICEWINDOWLAYOUT_HPP
+#define QOFFICE_OFFICEWINDOWLAYOUT_HPP
+
+
+// QOffice headers
+#include <QOffice/Config.hpp>
+
+// Qt headers
+#include <QLayout>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+/**
+ * Top-level layout of an OfficeWindow that places its content
+ * below the title bar and within the drop shadow. If the window
+ * is maximized or restored, the content is moved to the new
+ * frame without invalidating the layouts within it.
+ *
+ * Holds exactly one item, which is usually another layout.
+ * Windows without an OfficeWindowLayout fall back to adjusting
+ * the margins of their layout, if they have one at all.
+ *
+ * @class OfficeWindowLayout
+ * @author Nicolas Kogler
+ * @date January 18th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeWindowLayout : public QLayout
+{
+public:
+
+    /**
+     * Initializes a new instance of OfficeWindowLayout and
+     * installs it on the given window.
+     *
+     * @param parent The window to lay out.
+     *
+     */
+    OfficeWindowLayout(QWidget* parent = nullptr);
+
+    /**
+     * Deletes the content of the layout.
+     *
+     */
+    ~OfficeWindowLayout();
+
+
+    /**
+     * Retrieves the margins occupied by the window frame.
+     *
+     * @param maximized True for the margins of a maximized window.
+     * @returns the title bar, border and shadow margins.
+     *
+     */
+    static QMargins frameMargins(bool maximized);
+
+    /**
+     * Determines whether the layout uses the frame
+     * margins of a maximized window.
+     *
+     * @returns true if it does.
+     *
+     */
+    bool isMaximized() const;
+
+    /**
+     * Specifies the frame margins to use. Moves the content
+     * to its new geometry without invalidating it.
+     *
+     * @param maximized True if the window is maximized.
+     *
+     */
+    void setMaximized(bool maximized);
+
+    /**
+     * Replaces the content with the given layout and
+     * takes ownership of it.
+     *
+     * @param layout The new content.
+     *
+     */
+    void setContentLayout(QLayout* layout);
+
+
+    /**
+     * Replaces the content with the given item.
+     *
+     * @param item The new content.
+     *
+     */
+    void addItem(QLayoutItem* item) override;
+
+    /**
+     * Retrieves the number of items, which is at most one.
+     *
+     * @returns the number of items.
+     *
+     */
+    int count() const override;
+
+    /**
+     * Retrieves the item at the given index.
+     *
+     * @param index The index of the item.
+     * @returns the item, nullptr if out of range.
+     *
+     */
+    QLayoutItem* itemAt(int index) const override;
+
+    /**
+     * Removes the item at the given index.
+     *
+     * @param index The index of the item.
+     * @returns the removed item, nullptr if out of range.
+     *
+     */
+    QLayoutItem* takeAt(int index) override;
+
+    /**
+     * Retrieves the preferred size of the window, which is
+     * always based on the frame of a restored window.
+     *
+     * @returns the size hint.
+     *
+     */
+    QSize sizeHint() const override;
+
+    /**
+     * Retrieves the minimum size of the window, which is
+     * always based on the frame of a restored window.
+     *
+     * @returns the minimum size.
+     *
+     */
+    QSize minimumSize() const override;
+
+    /**
+     * Retrieves the maximum size of the window.
+     *
+     * @returns the maximum size.
+     *
+     */
+    QSize maximumSize() const override;
+
+    /**
+     * Retrieves the directions in which the content expands.
+     *
+     * @returns the expanding directions.
+     *
+     */
+    Qt::Orientations expandingDirections() const override;
+
+    /**
+     * Places the content within the frame.
+     *
+     * @param rect The geometry of the window.
+     *
+     */
+    void setGeometry(const QRect& rect) override;
+
+
+private:
+
+    // Members
+    QLayoutItem* m_Content;
+    bool m_Maximized;
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     auto* frame = new OfficeWindowLayout(window);
+ *     frame->setContentLayout(new QVBoxLayout);
+ * @endcode
+ *
+ */
+
+#endif // QOFFICE_OFFICEWINDOWLAYOUT_HPP
@@ -0,0 +1,224 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICEWINDOWPOOL_HPP
+#define QOFFICE_OFFICEWINDOWPOOL_HPP
+
+
+// QOffice headers
+#include <QOffice/Config.hpp>
+#include <QOffice/Interfaces/IOfficeWidget.hpp>
+
+// Qt headers
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+
+// Standard headers
+#include <functional>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+class OfficeResourceContext;
+class OfficeWindow;
+
+
+/**
+ * Keeps a number of hidden, fully constructed and polished
+ * windows, so a dialog can be shown in response to a click
+ * without constructing it first. Windows are built one at a
+ * time while the event loop is idle, and closed windows are
+ * recycled.
+ *
+ * Recycled windows get their frame restored to the state
+ * the factory built: the title, accent, custom caption items,
+ * caption button visibility and the resizability. The content
+ * built by the factory, i.e. the layout and the child widgets,
+ * is kept as it is, since reusing it is the reason to pool
+ * windows. Use a recycler to reset the state of the content,
+ * e.g. to clear input fields.
+ * Must only be used from within the GUI thread.
+ *
+ * @class OfficeWindowPool
+ * @author Nicolas Kogler
+ * @date January 19th, 2017
+ *
+ */
+class QOFFICE_EXPORT OfficeWindowPool : public QObject
+{
+public:
+
+    /**
+     * Creates the windows of a pool.
+     *
+     * @typedef Factory
+     *
+     */
+    typedef std::function<OfficeWindow*()> Factory;
+
+    /**
+     * Resets the content of a window that returns to the pool.
+     *
+     * @typedef Recycler
+     *
+     */
+    typedef std::function<void(OfficeWindow*)> Recycler;
+
+
+    /**
+     * Initializes a new pool and starts filling it.
+     *
+     * @param capacity The number of windows to keep.
+     * @param factory Creates a window, nullptr for OfficeWindow.
+     * @param parent The parent of the pool.
+     *
+     */
+    OfficeWindowPool(int capacity, Factory factory = nullptr, QObject* parent = nullptr);
+
+    /**
+     * Deletes all windows that are kept by the pool.
+     * Windows that have been handed out are left alone.
+     *
+     */
+    ~OfficeWindowPool();
+
+
+    /**
+     * Retrieves the number of windows to keep.
+     *
+     * @returns the capacity.
+     *
+     */
+    int capacity() const;
+
+    /**
+     * Retrieves the number of windows ready to be handed out.
+     *
+     * @returns the number of pooled windows.
+     *
+     */
+    int available() const;
+
+    /**
+     * Specifies the number of windows to keep. Deletes
+     * or creates windows to match it.
+     *
+     * @param capacity The number of windows to keep.
+     *
+     */
+    void setCapacity(int capacity);
+
+    /**
+     * Specifies the function that resets the content of
+     * windows returning to the pool.
+     *
+     * @param recycler Resets the content, nullptr for none.
+     *
+     */
+    void setRecycler(Recycler recycler);
+
+
+    /**
+     * Hands out a hidden window, constructing one if the
+     * pool is empty. Once the window is closed, it returns
+     * to the pool automatically.
+     *
+     * @returns the window, to be shown by the caller.
+     *
+     */
+    OfficeWindow* acquire();
+
+    /**
+     * Returns the given window to the pool with its frame
+     * restored, or deletes it if the pool is full.
+     *
+     * @param window The window to return.
+     *
+     */
+    void release(OfficeWindow* window);
+
+
+protected:
+
+    /**
+     * Recycles handed out windows once they are closed.
+     *
+     */
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+
+private:
+
+    /**
+     * Holds the frame of a window as built by the factory.
+     *
+     */
+    struct FrameState
+    {
+        QString title;
+        IOfficeWidget::Accent accent;
+        bool accentAnimated;
+        bool closeButton;
+        bool maximizeButton;
+        bool minimizeButton;
+        bool resizable;
+        QList<int> captionItems;
+        QList<bool> captionVisible;
+    };
+
+    // Helpers
+    OfficeWindow* create();
+    void scheduleFill();
+    void fill();
+
+    // Members
+    QList<OfficeWindow*> m_Windows;
+    QHash<OfficeWindow*, FrameState> m_Frames;
+    QSharedPointer<OfficeResourceContext> m_Resources;
+    Factory m_Factory;
+    Recycler m_Recycler;
+    int m_Capacity;
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     auto* pool = new OfficeWindowPool(2, [] () {
+ *         return new SettingsDialog;
+ *     }, this);
+ *
+ *     pool->acquire()->show();
+ * @endcode
+ *
+ */
+
+#endif // QOFFICE_OFFICEWINDOWPOOL_HPP
@@ -22,6 +22,7 @@
 
 // QOffice headers
 #include <QOffice/Design/OfficeAccents.hpp>
+#include <QOffice/Design/OfficePalette.hpp>
 #include <QOffice/Design/Exceptions/InvalidAccentException.hpp>
 
 
@@ -52,10 +53,27 @@ OfficeAccents::darker(const QColor& accent)
 }
 
 
+const QColor
+OfficeAccents::blend(const QColor& from, const QColor& to, qreal t)
+{
+    if (t <= 0.0)
+        return from;
+    if (t >= 1.0)
+        return to;
+
+    return QColor::fromRgbF(
+            from.redF()   + (to.redF()   - from.redF())   * t,
+            from.greenF() + (to.greenF() - from.greenF()) * t,
+            from.blueF()  + (to.blueF()  - from.blueF())  * t,
+            from.alphaF() + (to.alphaF() - from.alphaF()) * t);
+}
+
+
 void
 OfficeAccents::set(const QColor& color)
 {
     g_Colors[IOfficeWidget::Custom] = color;
+    OfficePalette::invalidate();
 }
 
 
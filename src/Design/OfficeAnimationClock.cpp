@@ -0,0 +1,109 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Design/OfficeAnimationClock.hpp>
+
+// Qt headers
+#include <QTimerEvent>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+#define ANIMATION_FRAME_TIME 16 ///< Time between two frames, in milliseconds
+
+
+OfficeAnimationClock::OfficeAnimationClock()
+    : QObject(nullptr)
+{
+    m_Elapsed.start();
+}
+
+
+OfficeAnimationClock*
+OfficeAnimationClock::instance()
+{
+    static OfficeAnimationClock clock;
+    return &clock;
+}
+
+
+qint64
+OfficeAnimationClock::time() const
+{
+    return m_Elapsed.elapsed();
+}
+
+
+bool
+OfficeAnimationClock::isAttached(IOfficeAnimated* animation) const
+{
+    return m_Animations.contains(animation);
+}
+
+
+void
+OfficeAnimationClock::attach(IOfficeAnimated* animation)
+{
+    if (m_Animations.contains(animation))
+        return;
+
+    m_Animations.append(animation);
+
+    // Only wakes up the event loop while animating.
+    if (!m_Timer.isActive())
+        m_Timer.start(ANIMATION_FRAME_TIME, Qt::PreciseTimer, this);
+}
+
+
+void
+OfficeAnimationClock::detach(IOfficeAnimated* animation)
+{
+    m_Animations.removeAll(animation);
+
+    if (m_Animations.isEmpty())
+        m_Timer.stop();
+}
+
+
+void
+OfficeAnimationClock::timerEvent(QTimerEvent* event)
+{
+    if (event->timerId() != m_Timer.timerId())
+    {
+        QObject::timerEvent(event);
+        return;
+    }
+
+    // Works on a copy, as animations may detach themselves.
+    const qint64 now = time();
+    const QList<IOfficeAnimated*> animations = m_Animations;
+    for (auto* animation : animations)
+    {
+        if (m_Animations.contains(animation) && !animation->advance(now))
+            m_Animations.removeAll(animation);
+    }
+
+    if (m_Animations.isEmpty())
+        m_Timer.stop();
+}
@@ -0,0 +1,201 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Design/OfficeGlyphs.hpp>
+#include <QOffice/Diagnostics/OfficeCounters.hpp>
+#include <QOffice/Diagnostics/OfficeMemory.hpp>
+
+// Qt headers
+#include <QCache>
+#include <QPainter>
+#include <QPainterPath>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+#define GLYPH_UNITS         10      ///< Glyphs are defined on a 10x10 grid
+#define GLYPH_STROKE        1.5     ///< Stroke width of the close glyph
+#define GLYPH_CACHE_LIMIT   256     ///< Maximum size of the glyph cache, in KB
+
+
+// Performance counters
+static OfficeCounter g_CacheHits("glyph.cache.hits");
+static OfficeCounter g_CacheMisses("glyph.cache.misses");
+
+
+/**
+ * Defines the given glyph on a grid of 10x10 units.
+ * The close glyph is stroked, all others are filled.
+ *
+ */
+static QPainterPath glyphPath(OfficeGlyphs::Glyph glyph)
+{
+    QPainterPath path;
+    path.setFillRule(Qt::OddEvenFill);
+
+    switch (glyph)
+    {
+        case OfficeGlyphs::Close:
+            path.moveTo(1, 1);
+            path.lineTo(9, 9);
+            path.moveTo(9, 1);
+            path.lineTo(1, 9);
+            break;
+
+        case OfficeGlyphs::Maximize:
+            path.addRect(0, 0, 10, 10);
+            path.addRect(1, 3, 8, 6);
+            break;
+
+        case OfficeGlyphs::Minimize:
+            path.addRect(1, 8, 8, 2);
+            break;
+
+        case OfficeGlyphs::Restore:
+            path.addRect(0, 3, 8, 7);
+            path.addRect(1, 5, 6, 4);
+            path.addRect(2, 0, 8, 2);
+            path.addRect(2, 2, 1, 1);
+            path.addRect(9, 2, 1, 5);
+            path.addRect(8, 6, 1, 1);
+            break;
+
+        default:
+            break;
+    }
+
+    return path;
+}
+
+
+/**
+ * Holds all rasterized glyphs. The cost of each glyph
+ * is its size in bytes.
+ *
+ */
+class GlyphCache : public IOfficeCache
+{
+public:
+
+    GlyphCache()
+        : m_Images(GLYPH_CACHE_LIMIT * 1024)
+        , m_LastAccess(0)
+    {
+        OfficeMemory::attach(this);
+    }
+
+    ~GlyphCache()
+    {
+        OfficeMemory::detach(this);
+    }
+
+    void collectUsage(OfficeMemoryUsage& usage) const override
+    {
+        usage.glyphs += m_Images.totalCost();
+    }
+
+    quint64 lastAccess() const override
+    {
+        return m_LastAccess;
+    }
+
+    void evict() override
+    {
+        m_Images.clear();
+    }
+
+    // Members
+    QCache<QString, QImage> m_Images;
+    quint64 m_LastAccess;
+};
+
+
+static GlyphCache& glyphCache()
+{
+    static GlyphCache cache;
+    return cache;
+}
+
+
+QImage
+OfficeGlyphs::get(Glyph glyph, const QSize& size, qreal dpr, const QColor& color)
+{
+    Q_ASSERT(glyph < Max);
+
+    const QString key = QString("%1-%2x%3-%4-%5")
+            .arg(glyph)
+            .arg(size.width())
+            .arg(size.height())
+            .arg(dpr)
+            .arg(color.rgba());
+
+    glyphCache().m_LastAccess = OfficeMemory::touch();
+    QImage* cached = glyphCache().m_Images.object(key);
+    if (cached != nullptr)
+    {
+        g_CacheHits.add();
+        return *cached;
+    }
+
+    g_CacheMisses.add();
+
+    const QImage image = render(glyph, size, dpr, color);
+    glyphCache().m_Images.insert(key, new QImage(image), image.byteCount());
+    OfficeMemory::commit(&glyphCache());
+
+    return image;
+}
+
+
+QImage
+OfficeGlyphs::render(Glyph glyph, const QSize& size, qreal dpr, const QColor& color)
+{
+    Q_ASSERT(glyph < Max);
+
+    QImage image(size * dpr, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+    image.fill(Qt::transparent);
+
+    // Scales the glyph definition to the requested size.
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.scale(qreal(size.width())  / GLYPH_UNITS,
+                  qreal(size.height()) / GLYPH_UNITS);
+
+    if (glyph == Close)
+        painter.strokePath(glyphPath(glyph), QPen(color, GLYPH_STROKE));
+    else
+        painter.fillPath(glyphPath(glyph), color);
+
+    painter.end();
+
+    return image;
+}
+
+
+void
+OfficeGlyphs::clear()
+{
+    glyphCache().evict();
+}
@@ -0,0 +1,237 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Design/OfficeIdleScheduler.hpp>
+#include <QOffice/Diagnostics/OfficeCounters.hpp>
+#include <QOffice/Diagnostics/OfficeTrace.hpp>
+
+// Qt headers
+#include <QTimerEvent>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+#define IDLE_FRAME_BUDGET 4 ///< Default time of a round of tasks, in milliseconds
+
+
+// Performance counters
+static OfficeCounter g_QueueDepth("idle.queueDepth", OfficeCounter::Gauge);
+static OfficeCounter g_TasksRun("idle.tasks");
+static OfficeCounter g_TasksSuperseded("idle.superseded");
+static OfficeCounter g_TasksCancelled("idle.cancelled");
+static OfficeCounter g_Rounds("idle.rounds");
+
+
+OfficeIdleScheduler::OfficeIdleScheduler()
+    : QObject(nullptr)
+    , m_Budget(IDLE_FRAME_BUDGET)
+{
+    m_Clock.start();
+}
+
+
+OfficeIdleScheduler*
+OfficeIdleScheduler::instance()
+{
+    static OfficeIdleScheduler scheduler;
+    return &scheduler;
+}
+
+
+int
+OfficeIdleScheduler::frameBudget() const
+{
+    return m_Budget;
+}
+
+
+int
+OfficeIdleScheduler::pending() const
+{
+    int count = 0;
+    for (const auto& queue : m_Tasks)
+        count += queue.size();
+
+    return count;
+}
+
+
+bool
+OfficeIdleScheduler::isScheduled(const void* owner, const char* name) const
+{
+    return const_cast<OfficeIdleScheduler*>(this)->find(owner, name) != nullptr;
+}
+
+
+const OfficeLatencyStats&
+OfficeIdleScheduler::latency() const
+{
+    return m_Latency;
+}
+
+
+void
+OfficeIdleScheduler::setFrameBudget(int msecs)
+{
+    m_Budget = qMax(0, msecs);
+}
+
+
+void
+OfficeIdleScheduler::schedule(const void* owner, const char* name, Priority priority, Task task)
+{
+    // Superseded tasks are replaced, but stay in line.
+    Entry* pending = find(owner, name);
+    if (pending != nullptr)
+    {
+        pending->task = std::move(task);
+        g_TasksSuperseded.add();
+        return;
+    }
+
+    Entry entry;
+    entry.owner = owner;
+    entry.name = name;
+    entry.task = std::move(task);
+    entry.queued = m_Clock.nsecsElapsed();
+
+    m_Tasks[priority].append(entry);
+    updateTimer();
+}
+
+
+void
+OfficeIdleScheduler::cancel(const void* owner, const char* name)
+{
+    for (auto& queue : m_Tasks)
+    {
+        for (int i = 0; i < queue.size(); ++i)
+        {
+            const Entry& entry = queue.at(i);
+            if (entry.owner == owner && qstrcmp(entry.name, name) == 0)
+            {
+                queue.remove(i);
+                g_TasksCancelled.add();
+                updateTimer();
+                return;
+            }
+        }
+    }
+}
+
+
+void
+OfficeIdleScheduler::cancelAll(const void* owner)
+{
+    for (auto& queue : m_Tasks)
+    {
+        for (int i = queue.size() - 1; i >= 0; --i)
+        {
+            if (queue.at(i).owner == owner)
+            {
+                queue.remove(i);
+                g_TasksCancelled.add();
+            }
+        }
+    }
+
+    updateTimer();
+}
+
+
+void
+OfficeIdleScheduler::timerEvent(QTimerEvent* event)
+{
+    if (event->timerId() != m_Timer.timerId())
+    {
+        QObject::timerEvent(event);
+        return;
+    }
+
+    g_Rounds.add();
+    QElapsedTimer round;
+    round.start();
+
+    // Runs at least one task, so that low priority tasks
+    // still make progress under a zero budget.
+    do
+    {
+        Entry entry;
+        bool found = false;
+        for (auto& queue : m_Tasks)
+        {
+            if (!queue.isEmpty())
+            {
+                entry = queue.takeFirst();
+                found = true;
+                break;
+            }
+        }
+
+        if (!found)
+            break;
+
+        // Tasks may schedule or cancel other tasks.
+        g_QueueDepth.set(pending());
+        m_Latency.add(m_Clock.nsecsElapsed() - entry.queued);
+        g_TasksRun.add();
+
+        QOFFICE_TRACE_SCOPE(entry.name, QSize());
+        entry.task();
+    }
+    while (round.elapsed() < m_Budget);
+
+    updateTimer();
+}
+
+
+OfficeIdleScheduler::Entry*
+OfficeIdleScheduler::find(const void* owner, const char* name)
+{
+    for (auto& queue : m_Tasks)
+    {
+        for (auto& entry : queue)
+        {
+            if (entry.owner == owner && qstrcmp(entry.name, name) == 0)
+                return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+
+void
+OfficeIdleScheduler::updateTimer()
+{
+    const int depth = pending();
+    g_QueueDepth.set(depth);
+
+    // Zero-timers fire once all window system events have
+    // been processed, which makes them idle callbacks.
+    if (depth == 0)
+        m_Timer.stop();
+    else if (!m_Timer.isActive())
+        m_Timer.start(0, this);
+}
@@ -22,25 +22,193 @@
 
 // QOffice headers
 #include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Design/OfficeAccents.hpp>
+#include <QOffice/Design/Exceptions/InvalidPaletteRoleException.hpp>
+#include <QOffice/Diagnostics/OfficeMemory.hpp>
+
+// Qt headers
+#include <QWidget>
 
 
 QOFFICE_USING_NAMESPACE
 
 
+#define PALETTE_KEY_PROPERTY "qoffice_palette_key"
+#define PALETTE_SIZE         (sizeof(QPalette) + sizeof(QBrush) * \
+                              QPalette::NColorGroups * QPalette::NColorRoles)
+
+
+/**
+ * Accounts for the cached QPalettes in OfficeMemory.
+ *
+ */
+class PaletteCache : public IOfficeCache
+{
+public:
+
+    PaletteCache(std::vector<QPalette>& palettes, std::vector<int>& epochs)
+        : m_Palettes(palettes)
+        , m_Epochs(epochs)
+        , m_LastAccess(0)
+    {
+        OfficeMemory::attach(this);
+    }
+
+    ~PaletteCache()
+    {
+        OfficeMemory::detach(this);
+    }
+
+    void collectUsage(OfficeMemoryUsage& usage) const override
+    {
+        for (int epoch : m_Epochs)
+        {
+            if (epoch != -1)
+                usage.palettes += PALETTE_SIZE;
+        }
+    }
+
+    quint64 lastAccess() const override
+    {
+        return m_LastAccess;
+    }
+
+    void evict() override
+    {
+        for (std::size_t i = 0; i < m_Palettes.size(); ++i)
+        {
+            m_Palettes[i] = QPalette();
+            m_Epochs[i] = -1;
+        }
+    }
+
+    // Members
+    std::vector<QPalette>& m_Palettes;
+    std::vector<int>& m_Epochs;
+    quint64 m_LastAccess;
+};
+
+
 const QColor&
 OfficePalette::get(PaletteRole role)
 {
     if (role >= PaletteRole::Max)
-        throw "placeholder";
+        throw InvalidPaletteRoleException(QOFFICE_FUNC, role);
 
     return g_Colors[role];
 }
 
 
+void
+OfficePalette::set(PaletteRole role, const QColor& color)
+{
+    if (role >= PaletteRole::Max)
+        throw InvalidPaletteRoleException(QOFFICE_FUNC, role);
+
+    g_Colors[role] = color;
+    invalidate();
+}
+
+
+int
+OfficePalette::epoch()
+{
+    return g_Epoch;
+}
+
+
+void
+OfficePalette::invalidate()
+{
+    g_Epoch++;
+}
+
+
+const QPalette&
+OfficePalette::palette(IOfficeWidget::Accent accent)
+{
+    static PaletteCache cache(g_Palettes, g_PaletteEpochs);
+
+    const QColor& colorAccnt = OfficeAccents::get(accent);
+    QPalette& palette = g_Palettes[accent];
+
+    // Only rebuilds the palette once per theme epoch.
+    cache.m_LastAccess = OfficeMemory::touch();
+    if (g_PaletteEpochs[accent] == g_Epoch)
+        return palette;
+
+    palette = QPalette();
+    palette.setColor(QPalette::Window, g_Colors[Background]);
+    palette.setColor(QPalette::WindowText, g_Colors[Foreground]);
+    palette.setColor(QPalette::Base, g_Colors[Base]);
+    palette.setColor(QPalette::AlternateBase, g_Colors[AlternateBase]);
+    palette.setColor(QPalette::Text, g_Colors[Text]);
+    palette.setColor(QPalette::Button, g_Colors[Button]);
+    palette.setColor(QPalette::ButtonText, g_Colors[ButtonText]);
+    palette.setColor(QPalette::BrightText, g_Colors[BrightText]);
+    palette.setColor(QPalette::Light, g_Colors[Light]);
+    palette.setColor(QPalette::Midlight, g_Colors[Midlight]);
+    palette.setColor(QPalette::Mid, g_Colors[Mid]);
+    palette.setColor(QPalette::Dark, g_Colors[Dark]);
+    palette.setColor(QPalette::Shadow, g_Colors[Shadow]);
+    palette.setColor(QPalette::Highlight, colorAccnt);
+    palette.setColor(QPalette::HighlightedText, g_Colors[HighlightedText]);
+    palette.setColor(QPalette::ToolTipBase, g_Colors[ToolTipBase]);
+    palette.setColor(QPalette::ToolTipText, g_Colors[ToolTipText]);
+    palette.setColor(QPalette::Link, colorAccnt);
+    palette.setColor(QPalette::LinkVisited, OfficeAccents::darker(colorAccnt));
+
+    // Disabled widgets render their text in a dimmed color.
+    palette.setColor(QPalette::Disabled, QPalette::WindowText, g_Colors[DisabledText]);
+    palette.setColor(QPalette::Disabled, QPalette::Text, g_Colors[DisabledText]);
+    palette.setColor(QPalette::Disabled, QPalette::ButtonText, g_Colors[DisabledText]);
+    palette.setColor(QPalette::Disabled, QPalette::Highlight, g_Colors[Mid]);
+
+    g_PaletteEpochs[accent] = g_Epoch;
+    OfficeMemory::commit(&cache);
+    return palette;
+}
+
+
+void
+OfficePalette::apply(QWidget* widget, IOfficeWidget::Accent accent)
+{
+    const int key = g_Epoch * ACCENT_COLOR_END + accent;
+    const QVariant current = widget->property(PALETTE_KEY_PROPERTY);
+
+    // Setting the palette on the top-level widget is enough, as
+    // Qt propagates it to every child without an own palette.
+    if (current.isValid() && current.toInt() == key)
+        return;
+
+    widget->setPalette(palette(accent));
+    widget->setProperty(PALETTE_KEY_PROPERTY, key);
+}
+
+
 // Specifies the predefined palette entries.
 std::vector<QColor> OfficePalette::g_Colors =
 {
     QColor(0xf1f1f1),
     QColor(0x666666),
-    QColor(0x989898)
+    QColor(0x989898),
+    QColor(0xffffff),
+    QColor(0xf8f8f8),
+    QColor(0x444444),
+    QColor(0xfdfdfd),
+    QColor(0x444444),
+    QColor(0xffffff),
+    QColor(0xffffff),
+    QColor(0xe1e1e1),
+    QColor(0xc6c6c6),
+    QColor(0xababab),
+    QColor(0x7a7a7a),
+    QColor(0xffffff),
+    QColor(0xffffff),
+    QColor(0x444444)
 };
+
+// Holds one cached QPalette per accent color.
+std::vector<QPalette> OfficePalette::g_Palettes(ACCENT_COLOR_END);
+std::vector<int> OfficePalette::g_PaletteEpochs(ACCENT_COLOR_END, -1);
+int OfficePalette::g_Epoch = 0;
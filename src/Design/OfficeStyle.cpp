@@ -0,0 +1,426 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Design/OfficeStyle.hpp>
+#include <QOffice/Design/OfficeAccents.hpp>
+#include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Diagnostics/OfficeCounters.hpp>
+#include <QOffice/Diagnostics/OfficeMemory.hpp>
+
+// Qt headers
+#include <QAbstractButton>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QPainter>
+#include <QPushButton>
+#include <QScrollBar>
+#include <QStyleOption>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+#define STYLE_CACHE_LIMIT   2048    ///< Default primitive cache size, in KB
+#define SCROLL_SLIDER_INSET 3       ///< Space between groove and slider
+
+#define CACHED_STATES       (QStyle::State_Enabled   | \
+                             QStyle::State_MouseOver | \
+                             QStyle::State_Sunken    | \
+                             QStyle::State_On        | \
+                             QStyle::State_HasFocus  | \
+                             QStyle::State_Horizontal)
+
+
+// Performance counters
+static OfficeCounter g_CacheHits("style.cache.hits");
+static OfficeCounter g_CacheMisses("style.cache.misses");
+
+
+/**
+ * Identifies the primitives cached by OfficeStyle.
+ *
+ * @enum CachedElement
+ *
+ */
+enum CachedElement
+{
+    ButtonBevel,
+    LineEditPanel,
+    LineEditFrame,
+    ScrollBarGroove,
+    ScrollBarSlider,
+    ComboBoxPanel
+};
+
+
+/**
+ * Determines whether the given widget is drawn with a
+ * border that takes the accent color once focused.
+ *
+ */
+static bool hasAccentFocus(const QWidget* widget)
+{
+    if (qobject_cast<const QPushButton*>(widget) || qobject_cast<const QLineEdit*>(widget))
+        return true;
+
+    auto* combo = qobject_cast<const QComboBox*>(widget);
+    return combo != nullptr && !combo->isEditable();
+}
+
+
+OfficeStyle::OfficeStyle(QStyle* base)
+    : QProxyStyle(base)
+    , m_Cache(STYLE_CACHE_LIMIT)
+    , m_LastAccess(0)
+{
+    OfficeMemory::attach(this);
+}
+
+
+OfficeStyle::~OfficeStyle()
+{
+    OfficeMemory::detach(this);
+}
+
+
+int
+OfficeStyle::cacheLimit() const
+{
+    return m_Cache.maxCost();
+}
+
+
+void
+OfficeStyle::setCacheLimit(int limit)
+{
+    m_Cache.setMaxCost(limit);
+}
+
+
+void
+OfficeStyle::clearCache()
+{
+    m_Cache.clear();
+}
+
+
+void
+OfficeStyle::collectUsage(OfficeMemoryUsage& usage) const
+{
+    usage.primitives += qint64(m_Cache.totalCost()) * 1024;
+}
+
+
+quint64
+OfficeStyle::lastAccess() const
+{
+    return m_LastAccess;
+}
+
+
+void
+OfficeStyle::evict()
+{
+    m_Cache.clear();
+}
+
+
+void
+OfficeStyle::drawPrimitive(
+        PrimitiveElement element,
+        const QStyleOption* option,
+        QPainter* painter,
+        const QWidget* widget) const
+{
+    const QPalette& pal = option->palette;
+    const QColor accent = pal.color(QPalette::Highlight);
+    const int state = option->state & CACHED_STATES;
+    const bool enabled = option->state & State_Enabled;
+    const bool hovered = option->state & State_MouseOver;
+    const bool focused = option->state & State_HasFocus;
+    const bool pressed = option->state & (State_Sunken | State_On);
+
+    switch (element)
+    {
+        case PE_PanelButtonCommand:
+        {
+            QColor fill = pal.color(QPalette::Button);
+            QColor border = pal.color(QPalette::Mid);
+
+            // Determines the colors by the button state.
+            if (!enabled)
+                border = pal.color(QPalette::Midlight);
+            else if (pressed)
+            {
+                fill = pal.color(QPalette::Midlight);
+                border = OfficeAccents::darker(accent);
+            }
+            else if (hovered || focused)
+            {
+                fill = pal.color(QPalette::Light);
+                border = accent;
+            }
+
+            drawCached(painter, option, ButtonBevel, state, option->rect,
+                [=](QPainter* p, const QRect& rc)
+                {
+                    p->fillRect(rc, fill);
+                    p->setPen(border);
+                    p->drawRect(rc.adjusted(0, 0, -1, -1));
+                });
+
+            return;
+        }
+
+        case PE_PanelLineEdit:
+        {
+            auto* frame = qstyleoption_cast<const QStyleOptionFrame*>(option);
+            bool hasFrame = frame != nullptr && frame->lineWidth > 0;
+
+            QColor fill = pal.color(QPalette::Base);
+            QColor border = pal.color(QPalette::Mid);
+            if (!enabled)
+            {
+                fill = pal.color(QPalette::Window);
+                border = pal.color(QPalette::Midlight);
+            }
+            else if (focused)
+                border = accent;
+            else if (hovered)
+                border = pal.color(QPalette::Dark);
+
+            drawCached(painter, option, hasFrame ? LineEditFrame : LineEditPanel,
+                       state, option->rect,
+                [=](QPainter* p, const QRect& rc)
+                {
+                    p->fillRect(rc, fill);
+                    if (hasFrame)
+                    {
+                        p->setPen(border);
+                        p->drawRect(rc.adjusted(0, 0, -1, -1));
+                    }
+                });
+
+            return;
+        }
+
+        case PE_FrameFocusRect:
+            // Office controls indicate the focus by their border,
+            // all others still need the focus rectangle.
+            if (hasAccentFocus(widget))
+                return;
+
+            break;
+
+        default:
+            break;
+    }
+
+    QProxyStyle::drawPrimitive(element, option, painter, widget);
+}
+
+
+void
+OfficeStyle::drawControl(
+        ControlElement element,
+        const QStyleOption* option,
+        QPainter* painter,
+        const QWidget* widget) const
+{
+    const QPalette& pal = option->palette;
+    const bool horizontal = option->state & State_Horizontal;
+
+    switch (element)
+    {
+        case CE_ScrollBarAddPage:
+        case CE_ScrollBarSubPage:
+        {
+            const QColor fill = pal.color(QPalette::Window);
+            const int state = option->state & State_Horizontal;
+
+            drawCached(painter, option, ScrollBarGroove, state, option->rect,
+                [=](QPainter* p, const QRect& rc)
+                {
+                    p->fillRect(rc, fill);
+                });
+
+            return;
+        }
+
+        case CE_ScrollBarSlider:
+        {
+            auto* slider = qstyleoption_cast<const QStyleOptionSlider*>(option);
+            bool active = slider != nullptr &&
+                          (slider->activeSubControls & SC_ScrollBarSlider);
+
+            // The slider is only hovered or pressed if the
+            // mouse pointer is on top of the slider itself.
+            int state = option->state & (State_Enabled | State_Horizontal);
+            if (active)
+                state |= option->state & (State_MouseOver | State_Sunken);
+
+            QColor fill = pal.color(QPalette::Mid);
+            if (state & State_Sunken)
+                fill = pal.color(QPalette::Shadow);
+            else if (state & State_MouseOver)
+                fill = pal.color(QPalette::Dark);
+
+            // Leaves some space between the slider and the groove.
+            const QColor groove = pal.color(QPalette::Window);
+            const QMargins inset = (horizontal)
+                    ? QMargins(0, SCROLL_SLIDER_INSET, 0, SCROLL_SLIDER_INSET)
+                    : QMargins(SCROLL_SLIDER_INSET, 0, SCROLL_SLIDER_INSET, 0);
+
+            drawCached(painter, option, ScrollBarSlider, state, option->rect,
+                [=](QPainter* p, const QRect& rc)
+                {
+                    p->fillRect(rc, groove);
+                    p->fillRect(rc.marginsRemoved(inset), fill);
+                });
+
+            return;
+        }
+
+        default:
+            break;
+    }
+
+    QProxyStyle::drawControl(element, option, painter, widget);
+}
+
+
+void
+OfficeStyle::drawComplexControl(
+        ComplexControl control,
+        const QStyleOptionComplex* option,
+        QPainter* painter,
+        const QWidget* widget) const
+{
+    auto* combo = qstyleoption_cast<const QStyleOptionComboBox*>(option);
+    if (control != CC_ComboBox || combo == nullptr || combo->editable)
+    {
+        QProxyStyle::drawComplexControl(control, option, painter, widget);
+        return;
+    }
+
+    const QPalette& pal = option->palette;
+    const int state = option->state & CACHED_STATES;
+    const bool enabled = option->state & State_Enabled;
+    const bool hovered = option->state & State_MouseOver;
+    const bool focused = option->state & State_HasFocus;
+
+    QColor fill = pal.color(QPalette::Base);
+    QColor border = pal.color(QPalette::Mid);
+    if (!enabled)
+    {
+        fill = pal.color(QPalette::Window);
+        border = pal.color(QPalette::Midlight);
+    }
+    else if (focused || (option->state & State_On))
+        border = pal.color(QPalette::Highlight);
+    else if (hovered)
+        border = pal.color(QPalette::Dark);
+
+    drawCached(painter, option, ComboBoxPanel, state, option->rect,
+        [=](QPainter* p, const QRect& rc)
+        {
+            p->fillRect(rc, fill);
+            p->setPen(border);
+            p->drawRect(rc.adjusted(0, 0, -1, -1));
+        });
+
+    // Renders the drop-down arrow on top of the cached panel.
+    QStyleOption arrow = *option;
+    arrow.rect = proxy()->subControlRect(CC_ComboBox, option, SC_ComboBoxArrow, widget);
+    proxy()->drawPrimitive(PE_IndicatorArrowDown, &arrow, painter, widget);
+}
+
+
+void
+OfficeStyle::polish(QWidget* widget)
+{
+    QProxyStyle::polish(widget);
+
+    // Hover states are only delivered if WA_Hover is set.
+    if (qobject_cast<QAbstractButton*>(widget) ||
+        qobject_cast<QComboBox*>(widget) ||
+        qobject_cast<QLineEdit*>(widget) ||
+        qobject_cast<QScrollBar*>(widget))
+    {
+        widget->setAttribute(Qt::WA_Hover);
+    }
+}
+
+
+void
+OfficeStyle::drawCached(
+        QPainter* painter,
+        const QStyleOption* option,
+        int element,
+        int state,
+        const QRect& rect,
+        const Renderer& render) const
+{
+    if (rect.isEmpty())
+        return;
+
+    // Builds a key that identifies the rendered primitive. The
+    // renderers use several palette colors, therefore the key
+    // covers the whole palette; widgets sharing the themed
+    // palette share its cache key, too.
+    const qreal dpr = painter->device()->devicePixelRatioF();
+    const QString key = QString("%1-%2-%3x%4-%5-%6-%7")
+            .arg(element)
+            .arg(state)
+            .arg(rect.width())
+            .arg(rect.height())
+            .arg(dpr)
+            .arg(option->palette.cacheKey())
+            .arg(OfficePalette::epoch());
+
+    // Repeated primitives become a simple blit.
+    m_LastAccess = OfficeMemory::touch();
+    QPixmap* cached = m_Cache.object(key);
+    if (cached != nullptr)
+    {
+        g_CacheHits.add();
+        painter->drawPixmap(rect.topLeft(), *cached);
+        return;
+    }
+
+    g_CacheMisses.add();
+
+    QPixmap pixmap(rect.size() * dpr);
+    pixmap.setDevicePixelRatio(dpr);
+    pixmap.fill(Qt::transparent);
+
+    QPainter pixmapPainter(&pixmap);
+    render(&pixmapPainter, QRect(QPoint(), rect.size()));
+    pixmapPainter.end();
+
+    // The cost of a primitive is its size in kilobytes.
+    int cost = qMax(1, pixmap.width() * pixmap.height() * 4 / 1024);
+    painter->drawPixmap(rect.topLeft(), pixmap);
+    m_Cache.insert(key, new QPixmap(pixmap), cost);
+    OfficeMemory::commit(const_cast<OfficeStyle*>(this));
+}
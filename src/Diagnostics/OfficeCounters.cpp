@@ -0,0 +1,130 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Diagnostics/OfficeCounters.hpp>
+
+// Qt headers
+#include <QJsonDocument>
+#include <QMutex>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+/**
+ * Holds all registered counters. Is constructed by the
+ * first counter, therefore outlives all of them.
+ *
+ */
+struct CounterRegistry
+{
+    QMutex mutex;
+    QList<OfficeCounter*> counters;
+};
+
+
+static CounterRegistry& counterRegistry()
+{
+    static CounterRegistry registry;
+    return registry;
+}
+
+
+OfficeCounter::OfficeCounter(const char* name, Kind kind)
+    : m_Name(name)
+    , m_Kind(kind)
+    , m_Value(0)
+{
+    CounterRegistry& registry = counterRegistry();
+    QMutexLocker lock(&registry.mutex);
+    registry.counters.append(this);
+}
+
+
+OfficeCounter::~OfficeCounter()
+{
+    CounterRegistry& registry = counterRegistry();
+    QMutexLocker lock(&registry.mutex);
+    registry.counters.removeOne(this);
+}
+
+
+QList<OfficeCounter*>
+OfficeCounters::all()
+{
+    CounterRegistry& registry = counterRegistry();
+    QMutexLocker lock(&registry.mutex);
+    return registry.counters;
+}
+
+
+qint64
+OfficeCounters::value(const char* name)
+{
+    for (auto* counter : all())
+    {
+        if (qstrcmp(counter->name(), name) == 0)
+            return counter->value();
+    }
+
+    return 0;
+}
+
+
+QJsonObject
+OfficeCounters::toJson()
+{
+    QJsonObject counters, gauges;
+    for (auto* counter : all())
+    {
+        QJsonObject& group = (counter->kind() == OfficeCounter::Gauge)
+                ? gauges
+                : counters;
+
+        group.insert(QLatin1String(counter->name()), double(counter->value()));
+    }
+
+    QJsonObject root;
+    root.insert(QStringLiteral("counters"), counters);
+    root.insert(QStringLiteral("gauges"), gauges);
+
+    return root;
+}
+
+
+QByteArray
+OfficeCounters::dump()
+{
+    return QJsonDocument(toJson()).toJson(QJsonDocument::Compact);
+}
+
+
+void
+OfficeCounters::reset()
+{
+    for (auto* counter : all())
+    {
+        if (counter->kind() == OfficeCounter::Counter)
+            counter->set(0);
+    }
+}
@@ -0,0 +1,144 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Diagnostics/OfficeLatencyStats.hpp>
+
+// Qt headers
+#include <QtAlgorithms>
+#include <QtMath>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+#define LATENCY_SUB_BITS    4       ///< Each power of two has 2^4 buckets
+#define LATENCY_SUB_COUNT   (1 << LATENCY_SUB_BITS)
+#define LATENCY_BUCKETS     (LATENCY_SUB_COUNT * (64 - LATENCY_SUB_BITS + 1))
+
+
+/**
+ * Retrieves the bucket of the given latency.
+ *
+ */
+static int latencyBucket(quint64 value)
+{
+    if (value < LATENCY_SUB_COUNT)
+        return static_cast<int>(value);
+
+    // Uses the highest bits below the leading one as sub-bucket.
+    const int exponent = 63 - qCountLeadingZeroBits(value);
+    const int shift = exponent - LATENCY_SUB_BITS;
+    const int sub = static_cast<int>(value >> shift) & (LATENCY_SUB_COUNT - 1);
+
+    return LATENCY_SUB_COUNT + shift * LATENCY_SUB_COUNT + sub;
+}
+
+
+/**
+ * Retrieves the center of the given bucket.
+ *
+ */
+static qint64 latencyValue(int bucket)
+{
+    if (bucket < LATENCY_SUB_COUNT)
+        return bucket;
+
+    const int shift = bucket / LATENCY_SUB_COUNT - 1;
+    const int sub = bucket % LATENCY_SUB_COUNT;
+    const quint64 lower = quint64(LATENCY_SUB_COUNT + sub) << shift;
+
+    return static_cast<qint64>(lower + (quint64(1) << shift) / 2);
+}
+
+
+OfficeLatencyStats::OfficeLatencyStats()
+    : m_Buckets(LATENCY_BUCKETS, 0)
+    , m_Count(0)
+    , m_Sum(0)
+    , m_Max(0)
+{
+}
+
+
+void
+OfficeLatencyStats::add(qint64 nsecs)
+{
+    nsecs = qMax(qint64(0), nsecs);
+
+    m_Buckets[latencyBucket(static_cast<quint64>(nsecs))]++;
+    m_Count++;
+    m_Sum += nsecs;
+    m_Max = qMax(m_Max, nsecs);
+}
+
+
+void
+OfficeLatencyStats::clear()
+{
+    m_Buckets.fill(0);
+    m_Count = 0;
+    m_Sum = 0;
+    m_Max = 0;
+}
+
+
+quint64
+OfficeLatencyStats::count() const
+{
+    return m_Count;
+}
+
+
+qint64
+OfficeLatencyStats::mean() const
+{
+    return (m_Count == 0) ? 0 : m_Sum / static_cast<qint64>(m_Count);
+}
+
+
+qint64
+OfficeLatencyStats::max() const
+{
+    return m_Max;
+}
+
+
+qint64
+OfficeLatencyStats::percentile(qreal fraction) const
+{
+    if (m_Count == 0)
+        return 0;
+
+    // Finds the bucket that contains the nearest-rank sample.
+    const quint64 rank = qMax(quint64(1), quint64(qCeil(fraction * m_Count)));
+    quint64 seen = 0;
+
+    for (int i = 0; i < m_Buckets.size(); ++i)
+    {
+        seen += m_Buckets.at(i);
+        if (seen >= rank)
+            return qMin(latencyValue(i), m_Max);
+    }
+
+    return m_Max;
+}
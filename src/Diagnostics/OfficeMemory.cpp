@@ -0,0 +1,191 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Diagnostics/OfficeMemory.hpp>
+#include <QOffice/Design/OfficeIdleScheduler.hpp>
+
+// Qt headers
+#include <QLoggingCategory>
+
+// Standard headers
+#include <algorithm>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+Q_LOGGING_CATEGORY(qofficeMemory, "qoffice.memory")
+
+
+/**
+ * Retrieves the number of bytes held by the given cache.
+ *
+ */
+static qint64 cacheSize(IOfficeCache* cache)
+{
+    OfficeMemoryUsage usage;
+    cache->collectUsage(usage);
+    return usage.total();
+}
+
+
+qint64
+OfficeMemoryUsage::total() const
+{
+    return shadows + glyphs + titles + primitives + palettes;
+}
+
+
+OfficeMemoryUsage&
+OfficeMemoryUsage::operator +=(const OfficeMemoryUsage& other)
+{
+    shadows += other.shadows;
+    glyphs += other.glyphs;
+    titles += other.titles;
+    primitives += other.primitives;
+    palettes += other.palettes;
+    return *this;
+}
+
+
+OfficeMemoryUsage
+OfficeMemory::usage()
+{
+    OfficeMemoryUsage usage;
+    for (auto* cache : g_Caches)
+        cache->collectUsage(usage);
+
+    return usage;
+}
+
+
+qint64
+OfficeMemory::budget()
+{
+    return g_Budget;
+}
+
+
+void
+OfficeMemory::setBudget(qint64 bytes)
+{
+    g_Budget = qMax(qint64(0), bytes);
+    evict();
+}
+
+
+void
+OfficeMemory::log()
+{
+    const OfficeMemoryUsage current = usage();
+
+    qCInfo(qofficeMemory,
+           "shadows=%lld glyphs=%lld titles=%lld primitives=%lld "
+           "palettes=%lld total=%lld budget=%lld",
+           current.shadows,
+           current.glyphs,
+           current.titles,
+           current.primitives,
+           current.palettes,
+           current.total(),
+           g_Budget);
+}
+
+
+void
+OfficeMemory::attach(IOfficeCache* cache)
+{
+    if (!g_Caches.contains(cache))
+        g_Caches.append(cache);
+}
+
+
+void
+OfficeMemory::detach(IOfficeCache* cache)
+{
+    g_Caches.removeAll(cache);
+}
+
+
+quint64
+OfficeMemory::touch()
+{
+    return ++g_Clock;
+}
+
+
+void
+OfficeMemory::commit(IOfficeCache*)
+{
+    if (g_Budget <= 0)
+        return;
+
+    // Growing caches several times in a row, e.g. while
+    // painting, results in only one check of the budget.
+    OfficeIdleScheduler::instance()->schedule(
+        &g_Budget, "OfficeMemory::evict", OfficeIdleScheduler::Low, &OfficeMemory::evict);
+}
+
+
+void
+OfficeMemory::evict()
+{
+    if (g_Budget <= 0)
+        return;
+
+    qint64 total = usage().total();
+    if (total <= g_Budget)
+        return;
+
+    // Evicts the least recently used caches first.
+    QList<IOfficeCache*> candidates = g_Caches;
+    std::sort(candidates.begin(), candidates.end(),
+        [](IOfficeCache* a, IOfficeCache* b)
+        {
+            return a->lastAccess() < b->lastAccess();
+        });
+
+    for (auto* candidate : candidates)
+    {
+        if (total <= g_Budget)
+            break;
+
+        const qint64 size = cacheSize(candidate);
+        if (size == 0)
+            continue;
+
+        candidate->evict();
+        total -= size - cacheSize(candidate);
+
+        qCDebug(qofficeMemory, "evicted %lld bytes, %lld bytes in use", size, total);
+    }
+
+    if (total > g_Budget)
+        qCWarning(qofficeMemory, "%lld bytes in use exceed the budget", total);
+}
+
+
+// Holds all attached caches and the budget.
+QList<IOfficeCache*> OfficeMemory::g_Caches;
+qint64 OfficeMemory::g_Budget = 0;
+quint64 OfficeMemory::g_Clock = 0;
@@ -0,0 +1,203 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Diagnostics/OfficeStartupTrace.hpp>
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QFile>
+#include <QLoggingCategory>
+
+// Standard headers
+#include <atomic>
+
+// Platform headers
+#if defined(Q_OS_WIN)
+    #include <windows.h>
+#elif defined(Q_OS_LINUX)
+    #include <unistd.h>
+#endif
+
+
+QOFFICE_USING_NAMESPACE
+
+
+Q_LOGGING_CATEGORY(qofficeStartup, "qoffice.startup")
+
+
+/**
+ * Determines how long the process has been running
+ * so far, in microseconds.
+ *
+ */
+static qint64 processAge()
+{
+#if defined(Q_OS_WIN)
+    FILETIME creation, exit, kernel, user, now;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        return 0;
+
+    GetSystemTimeAsFileTime(&now);
+
+    // Both times are given in units of 100 nanoseconds.
+    ULARGE_INTEGER start, current;
+    start.LowPart = creation.dwLowDateTime;
+    start.HighPart = creation.dwHighDateTime;
+    current.LowPart = now.dwLowDateTime;
+    current.HighPart = now.dwHighDateTime;
+
+    return static_cast<qint64>(current.QuadPart - start.QuadPart) / 10;
+#elif defined(Q_OS_LINUX)
+    QFile stat("/proc/self/stat");
+    QFile uptime("/proc/uptime");
+    if (!stat.open(QFile::ReadOnly) || !uptime.open(QFile::ReadOnly))
+        return 0;
+
+    // The process name may contain spaces, therefore the
+    // fields are counted from its closing parenthesis.
+    const QByteArray line = stat.readAll();
+    const QList<QByteArray> fields = line.mid(line.lastIndexOf(')') + 2).split(' ');
+    if (fields.size() < 20)
+        return 0;
+
+    // The start time (field 22) is given in clock ticks since boot.
+    const double ticks = static_cast<double>(sysconf(_SC_CLK_TCK));
+    const double started = fields.at(19).toDouble() / ticks;
+    const double running = uptime.readAll().split(' ').first().toDouble();
+
+    return qMax(qint64(0), static_cast<qint64>((running - started) * 1000000));
+#else
+    return 0;
+#endif
+}
+
+
+/**
+ * Holds the startup clock, which starts when the library
+ * is loaded. Phases are recorded relative to that point.
+ *
+ */
+struct StartupClock
+{
+    StartupClock()
+    {
+        for (auto& time : times)
+            time = -1;
+
+        timer.start();
+    }
+
+    // Members
+    QElapsedTimer timer;
+    std::atomic<qint64> times[OfficeStartupTrace::Max];
+};
+
+
+static StartupClock& startupClock()
+{
+    static StartupClock clock;
+    return clock;
+}
+
+
+/**
+ * Determines how long the process had been running before
+ * the library was loaded. Is computed on first use, as it
+ * may involve file I/O, which every process would otherwise
+ * pay for during static initialization.
+ *
+ */
+static qint64 loadOffset()
+{
+    static const qint64 offset =
+            qMax(qint64(0), processAge() - startupClock().timer.nsecsElapsed() / 1000);
+
+    return offset;
+}
+
+
+// Records the library load during static initialization.
+static const bool g_LibraryLoaded =
+        (OfficeStartupTrace::mark(OfficeStartupTrace::LibraryLoad), true);
+
+
+void
+OfficeStartupTrace::mark(Phase phase)
+{
+    Q_ASSERT(phase < Max);
+    StartupClock& clock = startupClock();
+
+    // Only the first time a phase is reached is of interest.
+    if (clock.times[phase].load(std::memory_order_relaxed) >= 0)
+        return;
+
+    qint64 expected = -1;
+    qint64 now = clock.timer.nsecsElapsed() / 1000;
+    clock.times[phase].compare_exchange_strong(expected, now);
+
+    if (phase == FirstPaint && qEnvironmentVariableIsSet("QOFFICE_STARTUP_TRACE"))
+        dump();
+}
+
+
+qint64
+OfficeStartupTrace::elapsed(Phase phase)
+{
+    Q_ASSERT(phase < Max);
+
+    const qint64 time = startupClock().times[phase].load();
+    return (time < 0) ? -1 : loadOffset() + time;
+}
+
+
+const char*
+OfficeStartupTrace::name(Phase phase)
+{
+    static const char* names[] =
+    {
+        "library load",
+        "resource context",
+        "first window",
+        "first drop shadow",
+        "first paint"
+    };
+
+    Q_ASSERT(phase < Max);
+    return names[phase];
+}
+
+
+void
+OfficeStartupTrace::dump()
+{
+    for (int i = 0; i < Max; ++i)
+    {
+        const Phase phase = static_cast<Phase>(i);
+        const qint64 time = elapsed(phase);
+
+        if (time >= 0)
+            qCInfo(qofficeStartup, "%s: %.3f ms", name(phase), time / 1000.0);
+        else
+            qCInfo(qofficeStartup, "%s: not reached", name(phase));
+    }
+}
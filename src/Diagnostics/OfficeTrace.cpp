@@ -0,0 +1,412 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Diagnostics/OfficeTrace.hpp>
+#include <QOffice/Diagnostics/OfficeWatchdog.hpp>
+
+// Qt headers
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+#include <QWidget>
+
+// Standard headers
+#include <atomic>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+#define TRACE_BUFFER_SIZE       8192    ///< Number of spans the ring buffer holds
+#define TRACE_FLUSH_INTERVAL    20      ///< Time between two flushes, in milliseconds
+
+
+/**
+ * Holds a completed span.
+ *
+ */
+struct TraceEvent
+{
+    const char* name;
+    quintptr window;
+    quintptr thread;
+    int width;
+    int height;
+    qint64 begin;
+    qint64 duration;
+};
+
+
+/**
+ * Holds a span within the ring buffer. The sequence tells
+ * producers and the consumer whether the slot is free.
+ *
+ */
+struct TraceSlot
+{
+    std::atomic<quint64> sequence;
+    TraceEvent event;
+};
+
+
+// Counts the spans dropped by all ring buffers.
+static std::atomic<quint64> g_Dropped(0);
+
+
+/**
+ * Bounded multi-producer single-consumer ring buffer. Spans
+ * are dropped instead of blocking the producer if full. The
+ * consumer sleeps while the buffer is empty and is only woken
+ * up by the first span that is pushed afterwards.
+ *
+ */
+class TraceBuffer
+{
+public:
+
+    TraceBuffer()
+        : m_Head(0)
+        , m_Tail(0)
+        , m_Waiting(false)
+    {
+        for (quint64 i = 0; i < TRACE_BUFFER_SIZE; ++i)
+            m_Slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    void push(const TraceEvent& event)
+    {
+        quint64 pos = m_Head.load(std::memory_order_relaxed);
+        TraceSlot* slot;
+
+        for (;;)
+        {
+            slot = &m_Slots[pos % TRACE_BUFFER_SIZE];
+            const quint64 seq = slot->sequence.load(std::memory_order_acquire);
+            const qint64 diff = static_cast<qint64>(seq - pos);
+
+            if (diff == 0)
+            {
+                // Claims the slot if no other producer was faster.
+                if (m_Head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                g_Dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else
+            {
+                pos = m_Head.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->event = event;
+        slot->sequence.store(pos + 1, std::memory_order_release);
+
+        // Orders the span before the check of the consumer state.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_Waiting.load(std::memory_order_relaxed))
+            wake();
+    }
+
+    void wait(const std::atomic<bool>& stop)
+    {
+        QMutexLocker lock(&m_Mutex);
+        m_Waiting.store(true, std::memory_order_relaxed);
+
+        // Orders the consumer state before the check for spans.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (isEmpty() && !stop.load())
+            m_Ready.wait(&m_Mutex);
+
+        m_Waiting.store(false, std::memory_order_relaxed);
+    }
+
+    void wake()
+    {
+        QMutexLocker lock(&m_Mutex);
+        m_Ready.wakeAll();
+    }
+
+    bool isEmpty() const
+    {
+        const TraceSlot* slot = &m_Slots[m_Tail % TRACE_BUFFER_SIZE];
+        return slot->sequence.load(std::memory_order_acquire) != m_Tail + 1;
+    }
+
+    bool pop(TraceEvent& event)
+    {
+        TraceSlot* slot = &m_Slots[m_Tail % TRACE_BUFFER_SIZE];
+        if (slot->sequence.load(std::memory_order_acquire) != m_Tail + 1)
+            return false;
+
+        // Hands the slot back to the producers.
+        event = slot->event;
+        slot->sequence.store(m_Tail + TRACE_BUFFER_SIZE, std::memory_order_release);
+        m_Tail++;
+
+        return true;
+    }
+
+private:
+
+    TraceSlot m_Slots[TRACE_BUFFER_SIZE];
+    std::atomic<quint64> m_Head;
+    quint64 m_Tail;
+    std::atomic<bool> m_Waiting;
+    QMutex m_Mutex;
+    QWaitCondition m_Ready;
+};
+
+
+/**
+ * Drains the ring buffer into the trace file in batches.
+ * Sleeps while no spans are completed.
+ *
+ */
+class TraceWriter : public QThread
+{
+public:
+
+    TraceWriter(QFile* file, TraceBuffer* buffer)
+        : m_File(file)
+        , m_Buffer(buffer)
+        , m_Stop(false)
+        , m_First(true)
+    {
+    }
+
+    void stop()
+    {
+        m_Stop.store(true);
+        m_Buffer->wake();
+        wait();
+    }
+
+protected:
+
+    void run() override
+    {
+        while (!m_Stop.load())
+        {
+            flush();
+            msleep(TRACE_FLUSH_INTERVAL);
+
+            // Sleeps until the next span while nothing happens.
+            m_Buffer->wait(m_Stop);
+        }
+
+        flush();
+    }
+
+private:
+
+    void flush()
+    {
+        const qint64 pid = QCoreApplication::applicationPid();
+        TraceEvent event;
+        char line[320];
+
+        while (m_Buffer->pop(event))
+        {
+            const int length = qsnprintf(line, sizeof(line),
+                    "%s{\"name\":\"%s\",\"cat\":\"qoffice\",\"ph\":\"X\","
+                    "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%lld,\"tid\":%llu,"
+                    "\"args\":{\"window\":\"0x%llx\",\"width\":%d,\"height\":%d}}",
+                    m_First ? "" : ",\n",
+                    event.name,
+                    event.begin / 1000.0,
+                    event.duration / 1000.0,
+                    static_cast<long long>(pid),
+                    static_cast<unsigned long long>(event.thread),
+                    static_cast<unsigned long long>(event.window),
+                    event.width,
+                    event.height);
+
+            m_File->write(line, qMin(length, int(sizeof(line)) - 1));
+            m_First = false;
+        }
+
+        m_File->flush();
+    }
+
+    QFile* m_File;
+    TraceBuffer* m_Buffer;
+    std::atomic<bool> m_Stop;
+    bool m_First;
+};
+
+
+// Static variables. The buffer only exists while tracing,
+// as it is too large to be allocated in every process.
+static std::atomic<TraceBuffer*> g_Buffer(nullptr);
+static std::atomic<int> g_Producers(0);
+static TraceWriter* g_Writer = nullptr;
+static QFile* g_File = nullptr;
+static std::atomic<bool> g_Enabled(false);
+
+
+static qint64 traceTime()
+{
+    static QElapsedTimer timer;
+    static bool started = (timer.start(), true);
+
+    Q_UNUSED(started);
+    return timer.nsecsElapsed();
+}
+
+
+bool
+OfficeTrace::start(const QString& path)
+{
+    stop();
+
+    g_File = new QFile(path);
+    if (!g_File->open(QFile::WriteOnly | QFile::Truncate))
+    {
+        delete g_File;
+        g_File = nullptr;
+        return false;
+    }
+
+    auto* buffer = new TraceBuffer;
+    g_Buffer.store(buffer);
+
+    g_File->write("[\n");
+    g_Writer = new TraceWriter(g_File, buffer);
+    g_Writer->start(QThread::LowPriority);
+    g_Enabled.store(true);
+
+    return true;
+}
+
+
+void
+OfficeTrace::stop()
+{
+    if (g_Writer == nullptr)
+        return;
+
+    g_Enabled.store(false);
+    TraceBuffer* buffer = g_Buffer.exchange(nullptr);
+
+    // Waits for the spans that are being pushed right now.
+    while (g_Producers.load() > 0)
+        QThread::yieldCurrentThread();
+
+    g_Writer->stop();
+    g_File->write("\n]\n");
+    g_File->close();
+
+    delete buffer;
+    delete g_Writer;
+    delete g_File;
+    g_Writer = nullptr;
+    g_File = nullptr;
+}
+
+
+bool
+OfficeTrace::isEnabled()
+{
+    return g_Enabled.load(std::memory_order_relaxed);
+}
+
+
+quint64
+OfficeTrace::dropped()
+{
+    return g_Dropped.load(std::memory_order_relaxed);
+}
+
+
+OfficeTraceScope::OfficeTraceScope(const char* name, const QWidget* widget)
+    : m_Name(name)
+    , m_Window(reinterpret_cast<quintptr>(widget))
+    , m_Size(widget->size())
+{
+    enter();
+}
+
+
+OfficeTraceScope::OfficeTraceScope(const char* name, const QSize& size)
+    : m_Name(name)
+    , m_Window(0)
+    , m_Size(size)
+{
+    enter();
+}
+
+
+OfficeTraceScope::~OfficeTraceScope()
+{
+    // Restores the breadcrumb of the enclosing scope.
+    m_Crumb->operation.store(m_PrevName, std::memory_order_relaxed);
+    m_Crumb->window.store(m_PrevWindow, std::memory_order_relaxed);
+    m_Crumb->width.store(m_PrevSize.width(), std::memory_order_relaxed);
+    m_Crumb->height.store(m_PrevSize.height(), std::memory_order_relaxed);
+
+    if (m_Begin < 0 || !OfficeTrace::isEnabled())
+        return;
+
+    TraceEvent event;
+    event.name = m_Name;
+    event.window = m_Window;
+    event.thread = reinterpret_cast<quintptr>(QThread::currentThreadId());
+    event.width = m_Size.width();
+    event.height = m_Size.height();
+    event.begin = m_Begin;
+    event.duration = traceTime() - m_Begin;
+
+    // Keeps stop() from freeing the buffer while pushing.
+    g_Producers.fetch_add(1);
+    TraceBuffer* buffer = g_Buffer.load();
+    if (buffer != nullptr)
+        buffer->push(event);
+
+    g_Producers.fetch_sub(1);
+}
+
+
+void
+OfficeTraceScope::enter()
+{
+    m_Crumb = &OfficeBreadcrumb::current();
+    m_PrevName = m_Crumb->operation.load(std::memory_order_relaxed);
+    m_PrevWindow = m_Crumb->window.load(std::memory_order_relaxed);
+    m_PrevSize = QSize(
+            m_Crumb->width.load(std::memory_order_relaxed),
+            m_Crumb->height.load(std::memory_order_relaxed));
+
+    // Leaves the breadcrumb for the watchdog.
+    m_Crumb->operation.store(m_Name, std::memory_order_relaxed);
+    m_Crumb->window.store(m_Window, std::memory_order_relaxed);
+    m_Crumb->width.store(m_Size.width(), std::memory_order_relaxed);
+    m_Crumb->height.store(m_Size.height(), std::memory_order_relaxed);
+
+    m_Begin = OfficeTrace::isEnabled() ? traceTime() : -1;
+}
@@ -0,0 +1,239 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Diagnostics/OfficeWatchdog.hpp>
+
+// Qt headers
+#include <QAbstractEventDispatcher>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+Q_LOGGING_CATEGORY(qofficeWatchdog, "qoffice.watchdog")
+
+
+/**
+ * Holds the state of the GUI event loop, shared
+ * with the watchdog thread.
+ *
+ */
+struct WatchdogState
+{
+    OfficeBreadcrumb* breadcrumb = nullptr;
+    std::atomic<qint64> busySince { -1 };
+    std::atomic<quint64> period { 0 };
+    std::atomic<quint64> stalls { 0 };
+    QMetaObject::Connection awake;
+    QMetaObject::Connection aboutToBlock;
+};
+
+
+static WatchdogState g_State;
+
+
+static qint64 watchdogTime()
+{
+    static QElapsedTimer timer;
+    static bool started = (timer.start(), true);
+
+    Q_UNUSED(started);
+    return timer.elapsed();
+}
+
+
+/**
+ * Periodically checks for how long the event loop has
+ * been busy. Sleeps until the event loop wakes up again
+ * while it is blocked, so that an idle application is
+ * not woken up by the watchdog.
+ *
+ */
+class WatchdogThread : public QThread
+{
+public:
+
+    WatchdogThread(int threshold)
+        : m_Threshold(threshold)
+        , m_Reported(0)
+        , m_Stop(false)
+    {
+    }
+
+    void stop()
+    {
+        m_Stop.store(true);
+        wake();
+        wait();
+    }
+
+    void wake()
+    {
+        QMutexLocker lock(&m_Mutex);
+        m_Busy.wakeOne();
+    }
+
+protected:
+
+    void run() override
+    {
+        // Checks four times per threshold to report stalls on time.
+        const unsigned long interval = qMax(1, m_Threshold / 4);
+        QMutexLocker lock(&m_Mutex);
+
+        while (!m_Stop.load())
+        {
+            // Holding the mutex while deciding guarantees
+            // that no wake-up of the event loop is missed.
+            if (g_State.busySince.load() < 0 || g_State.period.load() == m_Reported)
+                m_Busy.wait(&m_Mutex);
+            else if (!m_Busy.wait(&m_Mutex, interval))
+                check();
+        }
+    }
+
+private:
+
+    void check()
+    {
+        const qint64 since = g_State.busySince.load();
+        const quint64 period = g_State.period.load();
+        if (since < 0 || period == m_Reported)
+            return;
+
+        const qint64 stalled = watchdogTime() - since;
+        if (stalled < m_Threshold)
+            return;
+
+        // Reports each busy period only once.
+        m_Reported = period;
+        g_State.stalls.fetch_add(1, std::memory_order_relaxed);
+
+        OfficeBreadcrumb* crumb = g_State.breadcrumb;
+        const char* operation = crumb->operation.load(std::memory_order_relaxed);
+
+        if (operation == nullptr)
+        {
+            qCWarning(qofficeWatchdog,
+                      "GUI thread stalled for %lld ms outside of QOffice",
+                      stalled);
+        }
+        else
+        {
+            qCWarning(qofficeWatchdog,
+                      "GUI thread stalled for %lld ms in %s "
+                      "(window=0x%llx, size=%dx%d)",
+                      stalled,
+                      operation,
+                      static_cast<unsigned long long>(crumb->window.load(std::memory_order_relaxed)),
+                      crumb->width.load(std::memory_order_relaxed),
+                      crumb->height.load(std::memory_order_relaxed));
+        }
+    }
+
+    int m_Threshold;
+    quint64 m_Reported;
+    std::atomic<bool> m_Stop;
+    QMutex m_Mutex;
+    QWaitCondition m_Busy;
+};
+
+
+static WatchdogThread* g_Thread = nullptr;
+
+
+OfficeBreadcrumb&
+OfficeBreadcrumb::current()
+{
+    static thread_local OfficeBreadcrumb crumb { { nullptr }, { 0 }, { 0 }, { 0 } };
+    return crumb;
+}
+
+
+void
+OfficeWatchdog::start(int threshold)
+{
+    stop();
+
+    auto* dispatcher = QAbstractEventDispatcher::instance(qApp->thread());
+    Q_ASSERT(dispatcher != nullptr);
+    Q_ASSERT(QThread::currentThread() == qApp->thread());
+
+    g_State.breadcrumb = &OfficeBreadcrumb::current();
+    g_State.busySince.store(watchdogTime());
+    g_State.period.fetch_add(1);
+
+    g_Thread = new WatchdogThread(threshold);
+    g_Thread->start(QThread::HighPriority);
+
+    // A busy period lasts from waking up until blocking again.
+    g_State.awake = QObject::connect(
+            dispatcher, &QAbstractEventDispatcher::awake, [] () {
+        if (g_State.busySince.load(std::memory_order_relaxed) < 0)
+        {
+            g_State.period.fetch_add(1, std::memory_order_relaxed);
+            g_State.busySince.store(watchdogTime(), std::memory_order_release);
+            g_Thread->wake();
+        }
+    });
+
+    g_State.aboutToBlock = QObject::connect(
+            dispatcher, &QAbstractEventDispatcher::aboutToBlock, [] () {
+        g_State.busySince.store(-1, std::memory_order_release);
+    });
+}
+
+
+void
+OfficeWatchdog::stop()
+{
+    if (g_Thread == nullptr)
+        return;
+
+    QObject::disconnect(g_State.awake);
+    QObject::disconnect(g_State.aboutToBlock);
+
+    g_Thread->stop();
+    delete g_Thread;
+    g_Thread = nullptr;
+}
+
+
+bool
+OfficeWatchdog::isRunning()
+{
+    return g_Thread != nullptr;
+}
+
+
+quint64
+OfficeWatchdog::stalls()
+{
+    return g_State.stalls.load(std::memory_order_relaxed);
+}
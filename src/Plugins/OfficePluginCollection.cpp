@@ -32,13 +32,19 @@ QOFFICE_USING_NAMESPACE
 OfficePluginCollection::OfficePluginCollection(QObject* parent)
     : QObject(parent)
 {
-    m_Plugins.append(new OfficeWidgetPlugin(this));
-    m_Plugins.append(new OfficeWindowPlugin(this));
 }
 
 
 QList<QDesignerCustomWidgetInterface *>
 OfficePluginCollection::customWidgets() const
 {
+    // Only instantiates the plugins once they are requested.
+    if (m_Plugins.isEmpty())
+    {
+        auto* self = const_cast<OfficePluginCollection*>(this);
+        m_Plugins.append(new OfficeWidgetPlugin(self));
+        m_Plugins.append(new OfficeWindowPlugin(self));
+    }
+
     return m_Plugins;
 }
@@ -56,53 +56,63 @@ OfficeWidgetPlugin::isContainer() const
 QString
 OfficeWidgetPlugin::name() const
 {
-    return "off::OfficeWidget";
+    return QStringLiteral("off::OfficeWidget");
 }
 
 
 QString
 OfficeWidgetPlugin::group() const
 {
-    return "QOffice Base Widgets";
+    return QStringLiteral("QOffice Base Widgets");
 }
 
 
 QString
 OfficeWidgetPlugin::includeFile() const
 {
-    return "QOfficeWidget";
+    return QStringLiteral("QOfficeWidget");
 }
 
 
 QString
 OfficeWidgetPlugin::domXml() const
 {
-    QFile xmlFile(":/qoffice/plugins/officewidget.xml");
-    if (xmlFile.open(QFile::ReadOnly) != true)
-        throw "XML missing for this plugin!";
+    // Only reads the XML file once.
+    if (m_DomXml.isNull())
+    {
+        QFile xmlFile(":/qoffice/plugins/officewidget.xml");
+        if (xmlFile.open(QFile::ReadOnly) != true)
+            throw "XML missing for this plugin!";
 
-    return QString(xmlFile.readAll());
+        m_DomXml = QString(xmlFile.readAll());
+    }
+
+    return m_DomXml;
 }
 
 
 QString
 OfficeWidgetPlugin::toolTip() const
 {
-    return "The base widget.";
+    return QStringLiteral("The base widget.");
 }
 
 
 QString
 OfficeWidgetPlugin::whatsThis() const
 {
-    return "OfficeWidget is the base class for all QOffice widgets.";
+    return QStringLiteral("OfficeWidget is the base class for all QOffice widgets.");
 }
 
 
 QIcon
 OfficeWidgetPlugin::icon() const
 {
-    return QIcon(":/qoffice/plugins/officewidget.png");
+    // Only decodes the icon once it is displayed.
+    if (m_Icon.isNull())
+        m_Icon = QIcon(":/qoffice/plugins/officewidget.png");
+
+    return m_Icon;
 }
 
 
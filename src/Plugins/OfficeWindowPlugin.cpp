@@ -56,53 +56,63 @@ OfficeWindowPlugin::isContainer() const
 QString
 OfficeWindowPlugin::name() const
 {
-    return "off::OfficeWindow";
+    return QStringLiteral("off::OfficeWindow");
 }
 
 
 QString
 OfficeWindowPlugin::group() const
 {
-    return "QOffice Dialogs";
+    return QStringLiteral("QOffice Dialogs");
 }
 
 
 QString
 OfficeWindowPlugin::includeFile() const
 {
-    return "QOfficeWindow";
+    return QStringLiteral("QOfficeWindow");
 }
 
 
 QString
 OfficeWindowPlugin::domXml() const
 {
-    QFile xmlFile(":/qoffice/plugins/officewindow.xml");
-    if (xmlFile.open(QFile::ReadOnly) != true)
-        throw "XML missing for this plugin!";
+    // Only reads the XML file once.
+    if (m_DomXml.isNull())
+    {
+        QFile xmlFile(":/qoffice/plugins/officewindow.xml");
+        if (xmlFile.open(QFile::ReadOnly) != true)
+            throw "XML missing for this plugin!";
 
-    return QString(xmlFile.readAll());
+        m_DomXml = QString(xmlFile.readAll());
+    }
+
+    return m_DomXml;
 }
 
 
 QString
 OfficeWindowPlugin::toolTip() const
 {
-    return "The base widget.";
+    return QStringLiteral("The base widget.");
 }
 
 
 QString
 OfficeWindowPlugin::whatsThis() const
 {
-    return "Defines the main office window.";
+    return QStringLiteral("Defines the main office window.");
 }
 
 
 QIcon
 OfficeWindowPlugin::icon() const
 {
-    return QIcon(":/qoffice/plugins/officewindow.png");
+    // Only decodes the icon once it is displayed.
+    if (m_Icon.isNull())
+        m_Icon = QIcon(":/qoffice/plugins/officewindow.png");
+
+    return m_Icon;
 }
 
 
@@ -0,0 +1,316 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Widgets/OfficeResourceContext.hpp>
+#include <QOffice/Widgets/OfficeWarmup.hpp>
+#include <QOffice/Widgets/Constants/OfficeWindowConstants.hpp>
+#include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Diagnostics/OfficeCounters.hpp>
+#include <QOffice/Diagnostics/OfficeMemory.hpp>
+#include <QOffice/Diagnostics/OfficeStartupTrace.hpp>
+#include <QOffice/Diagnostics/OfficeTrace.hpp>
+
+// Qt headers
+#include <QHash>
+#include <QPainter>
+#include <QPainterPath>
+#include <QWeakPointer>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+// Performance counters
+static OfficeCounter g_ShadowGenerations("shadow.generations");
+
+
+/**
+ * Blurs one dimension of the given alpha values with a
+ * box filter. Values outside the buffer are transparent.
+ *
+ */
+static void boxBlur(
+        const int* in,
+        int* out,
+        int count,
+        int stride,
+        int lines,
+        int lineStride,
+        int radius)
+{
+    const int size = radius * 2 + 1;
+
+    for (int l = 0; l < lines; ++l)
+    {
+        const int* src = in + l * lineStride;
+        int* dst = out + l * lineStride;
+        int sum = 0;
+
+        // Fills the sliding window of the first value.
+        for (int i = 0; i <= radius && i < count; ++i)
+            sum += src[i * stride];
+
+        for (int i = 0; i < count; ++i)
+        {
+            dst[i * stride] = sum / size;
+
+            if (i + radius + 1 < count)
+                sum += src[(i + radius + 1) * stride];
+            if (i - radius >= 0)
+                sum -= src[(i - radius) * stride];
+        }
+    }
+}
+
+
+/**
+ * Holds the contexts that are referenced by at least
+ * one window, by their device pixel ratio.
+ *
+ */
+static QHash<qreal, QWeakPointer<OfficeResourceContext>>& contexts()
+{
+    static QHash<qreal, QWeakPointer<OfficeResourceContext>> contexts;
+    return contexts;
+}
+
+
+OfficeResourceContext::OfficeResourceContext(qreal dpr)
+    : m_Dpr(dpr)
+    , m_GlyphEpoch(-1)
+    , m_LastAccess(0)
+{
+    // Specifies the title rendering options.
+    m_TitleOptions.setAlignment(Qt::AlignCenter);
+    m_TitleOptions.setWrapMode(QTextOption::NoWrap);
+
+    OfficeMemory::attach(this);
+}
+
+
+OfficeResourceContext::~OfficeResourceContext()
+{
+    OfficeMemory::detach(this);
+}
+
+
+QSharedPointer<OfficeResourceContext>
+OfficeResourceContext::acquire(qreal dpr)
+{
+    QSharedPointer<OfficeResourceContext> context = contexts().value(dpr);
+    if (context.isNull())
+    {
+        context = QSharedPointer<OfficeResourceContext>(new OfficeResourceContext(dpr));
+        contexts().insert(dpr, context);
+        OfficeStartupTrace::mark(OfficeStartupTrace::ResourceContext);
+    }
+
+    return context;
+}
+
+
+qreal
+OfficeResourceContext::devicePixelRatio() const
+{
+    return m_Dpr;
+}
+
+
+const QTextOption&
+OfficeResourceContext::titleOptions() const
+{
+    return m_TitleOptions;
+}
+
+
+const QImage&
+OfficeResourceContext::glyph(OfficeGlyphs::Glyph glyph) const
+{
+    Q_ASSERT(glyph < OfficeGlyphs::Max);
+    m_LastAccess = OfficeMemory::touch();
+
+    // Re-rasterizes the glyphs if the palette has changed.
+    if (m_GlyphEpoch != OfficePalette::epoch())
+    {
+        for (auto& image : m_Glyphs)
+            image = QImage();
+
+        m_GlyphEpoch = OfficePalette::epoch();
+    }
+
+    QImage& image = m_Glyphs[glyph];
+    if (image.isNull())
+    {
+        const QColor& color = OfficePalette::get(OfficePalette::Background);
+        image = OfficeWarmup::takeGlyph(glyph, m_Dpr, color);
+    }
+    if (image.isNull())
+    {
+        image = OfficeGlyphs::get(
+                    glyph,
+                    QSize(WINDOW_GLYPH_SIZE, WINDOW_GLYPH_SIZE),
+                    m_Dpr,
+                    OfficePalette::get(OfficePalette::Background));
+    }
+
+    return image;
+}
+
+
+const QImage&
+OfficeResourceContext::dropShadow() const
+{
+    m_LastAccess = OfficeMemory::touch();
+    if (m_DropShadow.isNull())
+    {
+        generateDropShadow();
+        OfficeMemory::commit(const_cast<OfficeResourceContext*>(this));
+    }
+
+    return m_DropShadow;
+}
+
+
+void
+OfficeResourceContext::drawDropShadow(QPainter* painter, const QRect& rect) const
+{
+    const QImage& tile = dropShadow();
+    const int c = qMin(SHADOW_TILE_CORNER, qMin(rect.width(), rect.height()) / 2);
+    const int p = qRound(SHADOW_TILE_CORNER * m_Dpr);
+    const int w = tile.width();
+    const int h = tile.height();
+    const int l = rect.left();
+    const int t = rect.top();
+    const int r = rect.right() - c + 1;
+    const int b = rect.bottom() - c + 1;
+
+    // Renders the four corners, which must not overlap.
+    painter->drawImage(QRect(l, t, c, c), tile, QRect(0, 0, p, p));
+    painter->drawImage(QRect(r, t, c, c), tile, QRect(w - p, 0, p, p));
+    painter->drawImage(QRect(l, b, c, c), tile, QRect(0, h - p, p, p));
+    painter->drawImage(QRect(r, b, c, c), tile, QRect(w - p, h - p, p, p));
+
+    // Stretches the edges, which are uniform along their axis.
+    // The center is always covered by the client area.
+    const int cw = rect.width() - c * 2;
+    const int ch = rect.height() - c * 2;
+
+    if (cw > 0)
+    {
+        painter->drawImage(QRect(l + c, t, cw, c), tile, QRect(p, 0, w - p * 2, p));
+        painter->drawImage(QRect(l + c, b, cw, c), tile, QRect(p, h - p, w - p * 2, p));
+    }
+    if (ch > 0)
+    {
+        painter->drawImage(QRect(l, t + c, c, ch), tile, QRect(0, p, p, h - p * 2));
+        painter->drawImage(QRect(r, t + c, c, ch), tile, QRect(w - p, p, p, h - p * 2));
+    }
+}
+
+
+void
+OfficeResourceContext::collectUsage(OfficeMemoryUsage& usage) const
+{
+    usage.shadows += m_DropShadow.byteCount();
+}
+
+
+quint64
+OfficeResourceContext::lastAccess() const
+{
+    return m_LastAccess;
+}
+
+
+void
+OfficeResourceContext::evict()
+{
+    for (auto& image : m_Glyphs)
+        image = QImage();
+
+    m_DropShadow = QImage();
+}
+
+
+void
+OfficeResourceContext::generateDropShadow() const
+{
+    // Adopts the tile rendered at startup, if there is one.
+    m_DropShadow = OfficeWarmup::takeDropShadow(m_Dpr);
+    if (m_DropShadow.isNull())
+        m_DropShadow = renderDropShadow(m_Dpr);
+
+    OfficeStartupTrace::mark(OfficeStartupTrace::FirstDropShadow);
+}
+
+
+QImage
+OfficeResourceContext::renderDropShadow(qreal dpr)
+{
+    // The tile is just large enough to hold all corners.
+    const int size = qRound((SHADOW_TILE_CORNER * 2 + 1) * dpr);
+    const qreal padding = DROP_SHADOW_PADDING * dpr;
+
+    QOFFICE_TRACE_SCOPE("OfficeResourceContext::renderDropShadow", QSize(size, size));
+    g_ShadowGenerations.add();
+
+    QImage shape(size, size, QImage::Format_ARGB32_Premultiplied);
+    shape.fill(Qt::transparent);
+
+    // Renders the rounded rectangle.
+    QPainter painter(&shape);
+    QPainterPath path;
+    path.addRoundedRect(
+            QRectF(padding, padding, size - padding * 2, size - padding * 2),
+            4 * dpr,
+            4 * dpr);
+
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillPath(path, Qt::black);
+    painter.end();
+
+    // Three box blurs approximate a gaussian blur.
+    const int count = size * size;
+    const int radius = qMax(1, qRound(DROP_SHADOW * 2 * dpr / 3));
+    QVector<int> alpha(count);
+    QVector<int> temp(count);
+
+    for (int i = 0; i < count; ++i)
+        alpha[i] = qAlpha(reinterpret_cast<const QRgb*>(shape.constBits())[i]);
+
+    for (int pass = 0; pass < 3; ++pass)
+    {
+        boxBlur(alpha.constData(), temp.data(), size, 1, size, size, radius);
+        boxBlur(temp.constData(), alpha.data(), size, size, size, 1, radius);
+    }
+
+    // Stores the blurred alpha values as black shadow.
+    QImage shadow(size, size, QImage::Format_ARGB32_Premultiplied);
+    shadow.setDevicePixelRatio(dpr);
+
+    QRgb* pixels = reinterpret_cast<QRgb*>(shadow.bits());
+    for (int i = 0; i < count; ++i)
+        pixels[i] = qRgba(0, 0, 0, alpha[i]);
+
+    return shadow;
+}
@@ -0,0 +1,292 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Widgets/OfficeWarmup.hpp>
+#include <QOffice/Widgets/OfficeResourceContext.hpp>
+#include <QOffice/Widgets/Constants/OfficeWindowConstants.hpp>
+#include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Diagnostics/OfficeMemory.hpp>
+
+// Qt headers
+#include <QGuiApplication>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QScreen>
+#include <QThread>
+
+// Standard headers
+#include <climits>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+/**
+ * Holds the assets prepared for one device pixel ratio.
+ *
+ */
+struct PreparedAssets
+{
+    qreal dpr;
+    QColor glyphColor;
+    QImage dropShadow;
+    QImage glyphs[OfficeGlyphs::Max];
+};
+
+
+/**
+ * Renders the assets of all device pixel ratios and
+ * publishes each set as soon as it is complete.
+ *
+ */
+class WarmupThread : public QThread
+{
+public:
+
+    WarmupThread(const QList<qreal>& dprs, const QColor& glyphColor)
+        : m_Dprs(dprs)
+        , m_GlyphColor(glyphColor)
+    {
+    }
+
+protected:
+
+    void run() override;
+
+private:
+
+    // Members
+    QList<qreal> m_Dprs;
+    QColor m_GlyphColor;
+};
+
+
+// Holds the worker and the assets it has prepared.
+static QMutex g_Mutex;
+static QList<PreparedAssets> g_Prepared;
+static WarmupThread* g_Worker = nullptr;
+
+
+void
+WarmupThread::run()
+{
+    const QSize glyphSize(WINDOW_GLYPH_SIZE, WINDOW_GLYPH_SIZE);
+
+    for (qreal dpr : m_Dprs)
+    {
+        // Renders without holding the lock, so that windows
+        // shown in the meantime do not have to wait.
+        PreparedAssets assets;
+        assets.dpr = dpr;
+        assets.glyphColor = m_GlyphColor;
+        assets.dropShadow = OfficeResourceContext::renderDropShadow(dpr);
+
+        for (int i = 0; i < OfficeGlyphs::Max; ++i)
+        {
+            assets.glyphs[i] = OfficeGlyphs::render(
+                        static_cast<OfficeGlyphs::Glyph>(i),
+                        glyphSize,
+                        dpr,
+                        m_GlyphColor);
+        }
+
+        QMutexLocker lock(&g_Mutex);
+        g_Prepared.append(assets);
+    }
+}
+
+
+/**
+ * Accounts for the prepared assets that no window has
+ * adopted yet, so that they count towards the memory
+ * budget and are evicted before any asset in use.
+ *
+ */
+class PreparedCache : public IOfficeCache
+{
+public:
+
+    PreparedCache()
+        : m_LastAccess(0)
+    {
+        OfficeMemory::attach(this);
+    }
+
+    ~PreparedCache()
+    {
+        OfficeMemory::detach(this);
+    }
+
+    void collectUsage(OfficeMemoryUsage& usage) const override
+    {
+        QMutexLocker lock(&g_Mutex);
+        for (const auto& assets : g_Prepared)
+        {
+            usage.shadows += assets.dropShadow.byteCount();
+            for (const auto& glyph : assets.glyphs)
+                usage.glyphs += glyph.byteCount();
+        }
+    }
+
+    quint64 lastAccess() const override
+    {
+        return m_LastAccess;
+    }
+
+    void evict() override
+    {
+        QMutexLocker lock(&g_Mutex);
+        g_Prepared.clear();
+    }
+
+    // Members
+    quint64 m_LastAccess;
+};
+
+
+static PreparedCache& preparedCache()
+{
+    static PreparedCache cache;
+    return cache;
+}
+
+
+/**
+ * Waits for the worker and releases the assets that
+ * were never adopted once the application is destroyed.
+ *
+ */
+static void finishWarmup()
+{
+    if (g_Worker != nullptr)
+    {
+        g_Worker->wait();
+        delete g_Worker;
+        g_Worker = nullptr;
+    }
+
+    preparedCache().evict();
+}
+
+
+/**
+ * Retrieves the assets prepared for the given device
+ * pixel ratio. The mutex must be locked by the caller.
+ *
+ */
+static PreparedAssets* findAssets(qreal dpr)
+{
+    for (auto& assets : g_Prepared)
+    {
+        if (qFuzzyCompare(assets.dpr, dpr))
+            return &assets;
+    }
+
+    return nullptr;
+}
+
+
+void
+OfficeWarmup::start(const QList<qreal>& dprs)
+{
+    if (isRunning())
+        return;
+
+    // The worker must not outlive the application.
+    if (g_Worker == nullptr)
+        qAddPostRoutine(&finishWarmup);
+
+    delete g_Worker;
+
+    // Warms up every screen if nothing else was specified.
+    QList<qreal> targets = dprs;
+    if (targets.isEmpty())
+    {
+        for (auto* screen : QGuiApplication::screens())
+        {
+            if (!targets.contains(screen->devicePixelRatio()))
+                targets.append(screen->devicePixelRatio());
+        }
+    }
+
+    // The palette is not thread-safe, hence the color is
+    // copied before the worker is started.
+    g_Worker = new WarmupThread(targets, OfficePalette::get(OfficePalette::Background));
+    preparedCache().m_LastAccess = OfficeMemory::touch();
+
+    // The memory accounting is only usable from within the
+    // GUI thread, hence the growth is reported from there.
+    QObject::connect(g_Worker, &QThread::finished, qApp, []
+    {
+        OfficeMemory::commit(&preparedCache());
+    });
+
+    g_Worker->start(QThread::LowPriority);
+}
+
+
+bool
+OfficeWarmup::isRunning()
+{
+    return g_Worker != nullptr && g_Worker->isRunning();
+}
+
+
+bool
+OfficeWarmup::wait(int msecs)
+{
+    if (g_Worker == nullptr)
+        return true;
+
+    return g_Worker->wait((msecs < 0) ? ULONG_MAX : static_cast<unsigned long>(msecs));
+}
+
+
+QImage
+OfficeWarmup::takeDropShadow(qreal dpr)
+{
+    QMutexLocker lock(&g_Mutex);
+
+    QImage image;
+    PreparedAssets* assets = findAssets(dpr);
+    if (assets != nullptr)
+        qSwap(image, assets->dropShadow);
+
+    return image;
+}
+
+
+QImage
+OfficeWarmup::takeGlyph(OfficeGlyphs::Glyph glyph, qreal dpr, const QColor& color)
+{
+    Q_ASSERT(glyph < OfficeGlyphs::Max);
+    QMutexLocker lock(&g_Mutex);
+
+    // Glyphs of an outdated palette are never handed out.
+    QImage image;
+    PreparedAssets* assets = findAssets(dpr);
+    if (assets != nullptr && assets->glyphColor == color)
+        qSwap(image, assets->glyphs[glyph]);
+
+    return image;
+}
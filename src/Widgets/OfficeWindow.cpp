@@ -22,14 +22,18 @@
 
 // QOffice headers
 #include <QOffice/Widgets/OfficeWindow.hpp>
+#include <QOffice/Widgets/OfficeResourceContext.hpp>
+#include <QOffice/Widgets/OfficeWindowLayout.hpp>
 #include <QOffice/Widgets/Constants/OfficeWindowConstants.hpp>
 #include <QOffice/Design/OfficeAccents.hpp>
+#include <QOffice/Design/OfficeAnimationClock.hpp>
 #include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Diagnostics/OfficeCounters.hpp>
+#include <QOffice/Diagnostics/OfficeStartupTrace.hpp>
+#include <QOffice/Diagnostics/OfficeTrace.hpp>
 
 // Qt headers
-#include <QGraphicsScene>
-#include <QGraphicsPixmapItem>
-#include <QGraphicsDropShadowEffect>
+#include <QCache>
 #include <QPainter>
 #include <QLayout>
 #include <QtEvents>
@@ -38,44 +42,154 @@
 QOFFICE_USING_NAMESPACE
 
 
+// Performance counters
+static OfficeCounter g_WindowsAlive("window.alive", OfficeCounter::Gauge);
+static OfficeCounter g_Paints("window.paints");
+static OfficeCounter g_Resizes("window.resizes");
+static OfficeCounter g_ResizeAreas("window.resizeAreas", OfficeCounter::Gauge);
+static OfficeCounter g_MouseMoves("window.mouseMoves");
+static OfficeCounter g_HoverMoves("caption.hoverMoves");
+static OfficeCounter g_AccentPropagations("accent.propagations");
+static OfficeCounter g_AccentVisited("accent.widgetsVisited");
+static OfficeCounter g_TitleHits("title.cache.hits");
+static OfficeCounter g_TitleMisses("title.cache.misses");
+static OfficeCounter g_TitleCoalesced("title.coalesced");
+
+
+#define TITLE_CACHE_LIMIT   64      ///< Maximum size of the title cache, in KB
+
+
+/**
+ * Holds elided titles by their title, width and font, so
+ * titles that are restored or shared by several windows
+ * are elided only once.
+ *
+ */
+class TitleCache : public IOfficeCache
+{
+public:
+
+    TitleCache()
+        : m_Titles(TITLE_CACHE_LIMIT * 1024)
+        , m_LastAccess(0)
+    {
+        OfficeMemory::attach(this);
+    }
+
+    ~TitleCache()
+    {
+        OfficeMemory::detach(this);
+    }
+
+    void collectUsage(OfficeMemoryUsage& usage) const override
+    {
+        usage.titles += m_Titles.totalCost();
+    }
+
+    quint64 lastAccess() const override
+    {
+        return m_LastAccess;
+    }
+
+    void evict() override
+    {
+        m_Titles.clear();
+    }
+
+    // Members
+    QCache<QString, QString> m_Titles;
+    quint64 m_LastAccess;
+};
+
+
+static TitleCache& titleCache()
+{
+    static TitleCache cache;
+    return cache;
+}
+
+
 OfficeWindow::OfficeWindow(QWidget* parent)
-    : QWidget(parent)
-    , m_CloseState(WinButtonState::None)
-    , m_MaximState(WinButtonState::None)
-    , m_MinimState(WinButtonState::None)
-    , m_HasCloseBtn(true)
-    , m_HasMaximBtn(true)
-    , m_HasMinimBtn(true)
-    , m_CanResize(true)
+    : OfficeWindow(WinFrameFeature::All, parent)
+{
+}
+
 
+OfficeWindow::OfficeWindow(WinFrameFeatures features, QWidget* parent)
+    : QWidget(parent)
+    , m_CaptionHot(-1)
+    , m_NextCaptionId(CaptionUser)
+    , m_CaptionState(WinButtonState::None)
+    , m_State(WindowState::None)
+    , m_Features(features)
+    , m_AccentStart(0)
+    , m_CanResize(features.testFlag(WinFrameFeature::Resizing))
+    , m_AccentAnimated(false)
+    , m_TitleDirty(true)
 {
+    m_Accent = IOfficeWidget::Blue;
+
     // Manipulates the widget attributes and flags
     // in order to create a frameless window.
     setWindowFlags(Qt::Window | Qt::FramelessWindowHint);
     setAttribute(Qt::WA_TranslucentBackground);
 
-    // Enables mouse tracking.
-    setMouseTracking(true);
+    // Creates the built-in caption buttons, from right to left.
+    for (int id : { CaptionClose, CaptionMaximize, CaptionMinimize })
+    {
+        if (id == CaptionMaximize && !features.testFlag(WinFrameFeature::Maximizing))
+            continue;
+
+        WinCaptionItem item;
+        item.id = id;
+        item.visible = true;
+        item.embedded = false;
+        m_CaptionItems.append(item);
+    }
+
+    // Shares all frame assets with the other windows.
+    m_Resources = OfficeResourceContext::acquire(devicePixelRatioF());
 
-    // Specifies the title rendering options.
-    m_TitleOptions.setAlignment(Qt::AlignCenter);
-    m_TitleOptions.setWrapMode(QTextOption::NoWrap);
+    // Only the caption buttons track the mouse pointer.
+    m_CaptionTracker = new WinCaptionTracker(this);
 
     // Creates the resizing areas on the window.
-    m_ResizeTopLeft     = new WinResizeArea(this, RESIZE_TL);
-    m_ResizeTopRight    = new WinResizeArea(this, RESIZE_TR);
-    m_ResizeBottomRight = new WinResizeArea(this, RESIZE_BR);
-    m_ResizeBottomLeft  = new WinResizeArea(this, RESIZE_BL);
-    m_ResizeTop         = new WinResizeArea(this, RESIZE_T);
-    m_ResizeLeft        = new WinResizeArea(this, RESIZE_L);
-    m_ResizeBottom      = new WinResizeArea(this, RESIZE_B);
-    m_ResizeRight       = new WinResizeArea(this, RESIZE_R);
+    if (features.testFlag(WinFrameFeature::Resizing))
+    {
+        m_ResizeTopLeft     = new WinResizeArea(this, RESIZE_TL);
+        m_ResizeTopRight    = new WinResizeArea(this, RESIZE_TR);
+        m_ResizeBottomRight = new WinResizeArea(this, RESIZE_BR);
+        m_ResizeBottomLeft  = new WinResizeArea(this, RESIZE_BL);
+        m_ResizeTop         = new WinResizeArea(this, RESIZE_T);
+        m_ResizeLeft        = new WinResizeArea(this, RESIZE_L);
+        m_ResizeBottom      = new WinResizeArea(this, RESIZE_B);
+        m_ResizeRight       = new WinResizeArea(this, RESIZE_R);
+        g_ResizeAreas.add(8);
+    }
+    else
+    {
+        m_ResizeTopLeft     = nullptr;
+        m_ResizeTopRight    = nullptr;
+        m_ResizeBottomRight = nullptr;
+        m_ResizeBottomLeft  = nullptr;
+        m_ResizeTop         = nullptr;
+        m_ResizeLeft        = nullptr;
+        m_ResizeBottom      = nullptr;
+        m_ResizeRight       = nullptr;
+    }
 
-    // Loads all the window button images.
-    m_CloseImage = QPixmap(":/qoffice/images/window/close.png");
-    m_MaximImage = QPixmap(":/qoffice/images/window/max.png");
-    m_MinimImage = QPixmap(":/qoffice/images/window/min.png");
-    m_RestoreImage = QPixmap(":/qoffice/images/window/restore.png");
+    g_WindowsAlive.add();
+    OfficeStartupTrace::mark(OfficeStartupTrace::FirstWindow);
+}
+
+
+OfficeWindow::~OfficeWindow()
+{
+    OfficeAnimationClock::instance()->detach(this);
+    g_WindowsAlive.add(-1);
+
+    if (m_Features.testFlag(WinFrameFeature::Resizing))
+        g_ResizeAreas.add(-8);
 }
 
 
@@ -96,21 +210,64 @@ OfficeWindow::accentColor() const
 bool
 OfficeWindow::hasCloseButton() const
 {
-    return m_HasCloseBtn;
+    return isCaptionItemVisible(CaptionClose);
 }
 
 
 bool
 OfficeWindow::hasMaximizeButton() const
 {
-    return m_HasMaximBtn;
+    return isCaptionItemVisible(CaptionMaximize);
 }
 
 
 bool
 OfficeWindow::hasMinimizeButton() const
 {
-    return m_HasMinimBtn;
+    return isCaptionItemVisible(CaptionMinimize);
+}
+
+
+bool
+OfficeWindow::isCaptionItemVisible(int id) const
+{
+    const int index = captionIndex(id);
+    return index >= 0 && m_CaptionItems.at(index).visible;
+}
+
+
+QList<int>
+OfficeWindow::captionItems() const
+{
+    QList<int> ids;
+    for (const WinCaptionItem& item : m_CaptionItems)
+    {
+        if (item.id >= CaptionUser)
+            ids.append(item.id);
+    }
+
+    return ids;
+}
+
+
+QWidget*
+OfficeWindow::captionWidget(int id) const
+{
+    const int index = captionIndex(id);
+    return (index < 0) ? nullptr : m_CaptionItems.at(index).widget.data();
+}
+
+
+WinFrameState
+OfficeWindow::frameState() const
+{
+    WinFrameState state;
+    const bool hot = m_CaptionHot >= 0 && m_CaptionHot < m_CaptionItems.size();
+    state.hotItem = (hot) ? m_CaptionItems.at(m_CaptionHot).id : -1;
+    state.hotState = m_CaptionState;
+    state.interaction = m_State;
+
+    return state;
 }
 
 
@@ -121,10 +278,40 @@ OfficeWindow::canResize() const
 }
 
 
+WinFrameFeatures
+OfficeWindow::frameFeatures() const
+{
+    return m_Features;
+}
+
+
+bool
+OfficeWindow::isAccentAnimated() const
+{
+    return m_AccentAnimated;
+}
+
+
+OfficeMemoryUsage
+OfficeWindow::memoryUsage() const
+{
+    OfficeMemoryUsage usage;
+    usage.titles = m_VisibleTitle.capacity() * sizeof(QChar);
+    m_Resources->collectUsage(usage);
+
+    return usage;
+}
+
+
 void
 OfficeWindow::setAccent(Accent accent)
 {
+    QOFFICE_TRACE_SCOPE("OfficeWindow::setAccent", this);
+
     const QList<QWidget*> matches = findChildren<QWidget*>();
+    g_AccentPropagations.add();
+    g_AccentVisited.add(matches.size());
+
     for (auto* widget : matches)
     {
         auto* officeWidget = dynamic_cast<IOfficeWidget*>(widget);
@@ -132,8 +319,27 @@ OfficeWindow::setAccent(Accent accent)
             officeWidget->setAccent(accent);
     }
 
+    // Fades from the color currently on screen to the new accent.
+    if (accent != m_Accent)
+    {
+        auto* clock = OfficeAnimationClock::instance();
+        if (m_AccentAnimated && isVisible())
+        {
+            m_AccentFrom = currentAccent();
+            m_AccentStart = clock->time();
+            clock->attach(this);
+        }
+        else
+        {
+            clock->detach(this);
+        }
+    }
+
+    // Themes all standard Qt widgets within this window.
+    OfficePalette::apply(this, accent);
+
     m_Accent = accent;
-    update();
+    repaintAccent();
 }
 
 
@@ -147,26 +353,126 @@ OfficeWindow::setAccentColor(AccentColor accent)
 void
 OfficeWindow::setCloseButtonVisible(bool close)
 {
-    m_HasCloseBtn = close;
-    updateButtonRects();
-    repaintTitleBar();
+    setCaptionItemVisible(CaptionClose, close);
 }
 
 
 void
 OfficeWindow::setMaximizeButtonVisible(bool maximize)
 {
-    m_HasMaximBtn = maximize;
-    updateButtonRects();
-    repaintTitleBar();
+    setCaptionItemVisible(CaptionMaximize, maximize);
 }
 
 
 void
 OfficeWindow::setMinimizeButtonVisible(bool minimize)
 {
-    m_HasMinimBtn = minimize;
-    updateButtonRects();
+    setCaptionItemVisible(CaptionMinimize, minimize);
+}
+
+
+void
+OfficeWindow::setCaptionItemVisible(int id, bool visible)
+{
+    const int index = captionIndex(id);
+    if (index < 0 || m_CaptionItems.at(index).visible == visible)
+        return;
+
+    WinCaptionItem& item = m_CaptionItems[index];
+    item.visible = visible;
+    if (!item.widget.isNull())
+        item.widget->setVisible(visible);
+
+    // Drops the highlight of an item that disappears.
+    if (!visible && index == m_CaptionHot)
+        setCaptionHot(-1, WinButtonState::None);
+
+    updateFrame(WinFrameInput::Caption);
+    repaintTitleBar();
+}
+
+
+int
+OfficeWindow::addCaptionButton(const QImage& icon)
+{
+    WinCaptionItem item;
+    item.id = m_NextCaptionId++;
+    item.visible = true;
+    item.embedded = false;
+    item.icon = icon;
+    m_CaptionItems.append(item);
+
+    updateFrame(WinFrameInput::Caption);
+    repaintTitleBar();
+
+    return item.id;
+}
+
+
+int
+OfficeWindow::addCaptionWidget(QWidget* widget)
+{
+    if (widget == nullptr)
+        return -1;
+
+    widget->setParent(this);
+    widget->installEventFilter(this);
+    widget->show();
+
+    WinCaptionItem item;
+    item.id = m_NextCaptionId++;
+    item.visible = true;
+    item.embedded = true;
+    item.widget = widget;
+    m_CaptionItems.append(item);
+
+    updateFrame(WinFrameInput::Caption);
+    repaintTitleBar();
+
+    return item.id;
+}
+
+
+void
+OfficeWindow::removeCaptionItem(int id)
+{
+    const int index = captionIndex(id);
+    if (index < 0 || id < CaptionUser)
+        return;
+
+    // Indices of the following items are about to shift.
+    setCaptionHot(-1, WinButtonState::None);
+
+    QWidget* widget = m_CaptionItems.at(index).widget;
+    if (widget != nullptr)
+    {
+        widget->removeEventFilter(this);
+        widget->hide();
+        widget->setParent(nullptr);
+    }
+
+    m_CaptionItems.remove(index);
+    updateFrame(WinFrameInput::Caption);
+    repaintTitleBar();
+}
+
+
+void
+OfficeWindow::clearCaptionItems(const QList<int>& keep)
+{
+    setCaptionHot(-1, WinButtonState::None);
+
+    for (int i = m_CaptionItems.size() - 1; i >= 0; --i)
+    {
+        const int id = m_CaptionItems.at(i).id;
+        if (id < CaptionUser || keep.contains(id))
+            continue;
+
+        delete m_CaptionItems.at(i).widget;
+        m_CaptionItems.remove(i);
+    }
+
+    updateFrame(WinFrameInput::Caption);
     repaintTitleBar();
 }
 
@@ -174,79 +480,107 @@ OfficeWindow::setMinimizeButtonVisible(bool minimize)
 void
 OfficeWindow::setResizable(bool resize)
 {
-    m_CanResize = resize;
-    updateResizeRects();
+    m_CanResize = resize && m_Features.testFlag(WinFrameFeature::Resizing);
+    updateFrame(WinFrameInput::Resizable);
     update();
 }
 
 
 void
-OfficeWindow::paintEvent(QPaintEvent*)
+OfficeWindow::setAccentAnimated(bool animated)
 {
+    m_AccentAnimated = animated;
+}
+
+
+void
+OfficeWindow::paintEvent(QPaintEvent* event)
+{
+    QOFFICE_TRACE_SCOPE("OfficeWindow::paintEvent", this);
+    g_Paints.add();
+
     QPainter painter(this);
     QRect borderRect = m_ClientRect.adjusted(0, 0, -1, -1);
 
     // Retrieves the color of the current accent.
     const QColor& colorBackg = OfficePalette::get(OfficePalette::Background);
-    const QColor& colorAccnt = OfficeAccents::get(accent());
+    const QColor colorAccnt = currentAccent();
+
+    // Switches the resources if moved to another screen.
+    if (m_Resources->devicePixelRatio() != devicePixelRatioF())
+        m_Resources = OfficeResourceContext::acquire(devicePixelRatioF());
 
     // Renders the drop shadow.
-    if (!isMaximized() && m_State != WindowState::Resizing)
-        painter.drawPixmap(QPoint(), m_DropShadow);
+    if (!isMaximized())
+        m_Resources->drawDropShadow(&painter, rect());
 
     // Renders the background and the border.
     painter.fillRect(m_ClientRect, colorBackg);
     painter.setPen(colorAccnt);
     painter.drawRect(borderRect);
 
+    // Elides the title once per frame, no matter how
+    // often it has changed since the last frame.
+    if (m_TitleDirty)
+        updateVisibleTitle();
+
     // Renders the title bar background and text.
     painter.fillRect(m_TitleRect, colorAccnt);
     painter.setFont(font());
     painter.setPen(colorBackg);
-    painter.drawText(m_TitleRect, m_VisibleTitle, m_TitleOptions);
-
-    // Renders the background color of the window buttons.
-    if (m_CloseState == WinButtonState::Hovered)
-        painter.fillRect(m_CloseRect, OfficeAccents::lighter(colorAccnt));
-    else if (m_MaximState == WinButtonState::Hovered)
-        painter.fillRect(m_MaximRect, OfficeAccents::lighter(colorAccnt));
-    else if (m_MinimState == WinButtonState::Hovered)
-        painter.fillRect(m_MinimRect, OfficeAccents::lighter(colorAccnt));
-    else if (m_CloseState == WinButtonState::Pressed)
-        painter.fillRect(m_CloseRect, OfficeAccents::darker(colorAccnt));
-    else if (m_MaximState == WinButtonState::Pressed)
-        painter.fillRect(m_MaximRect, OfficeAccents::darker(colorAccnt));
-    else if (m_MinimState == WinButtonState::Pressed)
-        painter.fillRect(m_MinimRect, OfficeAccents::darker(colorAccnt));
-
-    // Renders the window button icons themselves.
-    if (m_HasCloseBtn)
-        painter.drawPixmap(centerRect(m_CloseImage, m_CloseRect), m_CloseImage);
-    if (m_HasMinimBtn)
-        painter.drawPixmap(centerRect(m_MinimImage, m_MinimRect), m_MinimImage);
-    if (m_HasMaximBtn)
-    {
-        if (!isMaximized())
-            painter.drawPixmap(centerRect(m_MaximImage, m_MaximRect), m_MaximImage);
-        else
-            painter.drawPixmap(centerRect(m_RestoreImage, m_MaximRect), m_RestoreImage);
+    painter.drawText(m_TitleRect, m_VisibleTitle, m_Resources->titleOptions());
+
+    // Renders the caption buttons that intersect the dirty area.
+    const QSize glyphSize(WINDOW_GLYPH_SIZE, WINDOW_GLYPH_SIZE);
+    for (int i = 0; i < m_CaptionItems.size(); ++i)
+    {
+        const WinCaptionItem& item = m_CaptionItems.at(i);
+        if (item.embedded || item.rect.isNull() || !event->rect().intersects(item.rect))
+            continue;
+
+        if (i == m_CaptionHot && m_CaptionState == WinButtonState::Hovered)
+            painter.fillRect(item.rect, OfficeAccents::lighter(colorAccnt));
+        else if (i == m_CaptionHot && m_CaptionState == WinButtonState::Pressed)
+            painter.fillRect(item.rect, OfficeAccents::darker(colorAccnt));
+
+        switch (item.id)
+        {
+        case CaptionClose:
+            painter.drawImage(
+                    centerRect(glyphSize, item.rect),
+                    m_Resources->glyph(OfficeGlyphs::Close));
+            break;
+        case CaptionMaximize:
+            painter.drawImage(
+                    centerRect(glyphSize, item.rect),
+                    m_Resources->glyph((isMaximized())
+                            ? OfficeGlyphs::Restore
+                            : OfficeGlyphs::Maximize));
+            break;
+        case CaptionMinimize:
+            painter.drawImage(
+                    centerRect(glyphSize, item.rect),
+                    m_Resources->glyph(OfficeGlyphs::Minimize));
+            break;
+        default:
+            painter.drawImage(
+                    centerRect(item.icon.size() / item.icon.devicePixelRatio(), item.rect),
+                    item.icon);
+            break;
+        }
     }
+
+    OfficeStartupTrace::mark(OfficeStartupTrace::FirstPaint);
 }
 
 
 void
 OfficeWindow::resizeEvent(QResizeEvent* event)
 {
-    // Does not generate a drop shadow if resizing
-    // or currently being in maximized window mode.
-    if (!isMaximized() && m_State != WindowState::Resizing)
-        generateDropShadow();
+    QOFFICE_TRACE_SCOPE("OfficeWindow::resizeEvent", this);
+    g_Resizes.add();
 
-    // Updates all rectangles, the title and the resize widgets.
-    updateButtonRects();
-    updateResizeRects();
-    updateVisibleTitle();
-    updateResizeWidgets();
+    updateFrame(WinFrameInput::Size);
 
     QWidget::resizeEvent(event);
 }
@@ -255,26 +589,25 @@ OfficeWindow::resizeEvent(QResizeEvent* event)
 void
 OfficeWindow::mouseMoveEvent(QMouseEvent* event)
 {
-    bool reqUpdate = false;
-    const QPoint p = event->pos();
+    QOFFICE_TRACE_SCOPE("OfficeWindow::mouseMoveEvent", this);
+    g_MouseMoves.add();
 
-    // Performs several hit-tests. If one of these
-    // functions returns true, the title bar will be redrawn.
+    // The window itself does not track the mouse, hence only
+    // moves with a held button arrive here. Only caption items
+    // whose state changes are repainted.
+    const QPoint p = event->pos();
     if (mouseMoveDrag(p))
         return;
-    if (mouseMoveSpecial(p))
-        reqUpdate = true;
-    if (mouseMoveHitTest(p))
-        reqUpdate = true;
 
-    if (reqUpdate)
-        repaintTitleBar();
+    mouseMoveCaption(p);
 }
 
 
 void
 OfficeWindow::mousePressEvent(QMouseEvent* event)
 {
+    QOFFICE_TRACE_SCOPE("OfficeWindow::mousePressEvent", this);
+
     // Only the left button triggers events.
     if (event->button() != Qt::LeftButton)
         return;
@@ -283,14 +616,16 @@ OfficeWindow::mousePressEvent(QMouseEvent* event)
     const QPoint p = event->pos();
     if (mousePressDrag(p))
         return;
-    if (mousePressHitTest(p))
-        repaintTitleBar();
+
+    mousePressCaption(p);
 }
 
 
 void
 OfficeWindow::mouseReleaseEvent(QMouseEvent* event)
 {
+    QOFFICE_TRACE_SCOPE("OfficeWindow::mouseReleaseEvent", this);
+
     // Only the left button triggers events.
     if (event->button() != Qt::LeftButton)
         return;
@@ -299,33 +634,27 @@ OfficeWindow::mouseReleaseEvent(QMouseEvent* event)
     const QPoint p = event->pos();
     if (mouseReleaseDrag(p))
         return;
-    if (mouseReleaseAction(p))
-        repaintTitleBar();
+
+    mouseReleaseCaption(p);
 }
 
 
 void
 OfficeWindow::mouseDoubleClickEvent(QMouseEvent* event)
 {
+    QOFFICE_TRACE_SCOPE("OfficeWindow::mouseDoubleClickEvent", this);
+
     // Only maximizes/restores under certain conditions.
     if (event->button() == Qt::LeftButton &&
         m_DragRect.contains(event->pos()) &&
-        m_CanResize && m_HasMaximBtn)
+        m_CanResize && isCaptionItemVisible(CaptionMaximize))
     {
         if (isMaximized())
-        {
             showNormal();
-            updateResizeRects();
-        }
         else
-        {
             showMaximized();
-            updateResizeRects();
-        }
 
-        m_MaximState = WinButtonState::None;
-        updateLayoutPadding();
-        update();
+        setCaptionHot(-1, WinButtonState::None);
     }
 }
 
@@ -334,44 +663,99 @@ void
 OfficeWindow::showEvent(QShowEvent*)
 {
     setAccent(m_Accent);
+
+    // Settings and layouts applied while the window was
+    // hidden need the frame, too.
+    updateResizeWidgets();
+    updateLayoutPadding();
+}
+
+
+bool
+OfficeWindow::advance(qint64 time)
+{
+    repaintAccent();
+
+    // Finishes the transition once the target color is reached.
+    return time - m_AccentStart < ACCENT_FADE_TIME;
 }
 
 
 void
-OfficeWindow::generateDropShadow()
+OfficeWindow::leaveEvent(QEvent*)
 {
-    // Creates a new pixmap that fills the entire widget.
-    m_DropShadow = QPixmap(size());
-    m_DropShadow.fill(Qt::transparent);
+    if (m_CaptionState == WinButtonState::Hovered)
+        setCaptionHot(-1, WinButtonState::None);
+}
 
-    QPainter painter(&m_DropShadow);
-    QPainterPath path;
 
-    // Defines the rounded rectangle.
-    QRectF rounded(
-            DROP_SHADOW_PADDING,
-            DROP_SHADOW_PADDING,
-            width()  - DROP_SHADOW_PADDING * 2,
-            height() - DROP_SHADOW_PADDING * 2);
+void
+OfficeWindow::changeEvent(QEvent* event)
+{
+    switch (event->type())
+    {
+    case QEvent::WindowStateChange:
+    {
+        // Minimizing does not affect the frame geometry.
+        auto* change = static_cast<QWindowStateChangeEvent*>(event);
+        if (change->oldState().testFlag(Qt::WindowMaximized) != isMaximized())
+        {
+            updateFrame(WinFrameInput::Maximized);
+            update();
+        }
+        break;
+    }
+    case QEvent::FontChange:
+        updateFrame(WinFrameInput::Font);
+        repaintTitleBar();
+        break;
+    case QEvent::WindowTitleChange:
+    {
+        // Repaints the span of the old title and the widest
+        // span the new title can take once it is elided.
+        QFontMetrics metrics(font());
+        const QRect before = titleTextBounds(metrics.width(m_VisibleTitle));
+        const QRect after = titleTextBounds(
+                    metrics.width(windowTitle()) + metrics.width(QStringLiteral("...")));
+
+        updateFrame(WinFrameInput::Title);
+        update(before | after);
+        break;
+    }
+    default:
+        break;
+    }
 
-    // Renders the rounded rectangle.
-    path.addRoundedRect(rounded, 4, 4);
-    painter.fillPath(path, Qt::black);
+    QWidget::changeEvent(event);
+}
 
-    // Prepares the pixmap for blurring.
-    QGraphicsScene scene;
-    QGraphicsPixmapItem item(m_DropShadow);
-    QGraphicsDropShadowEffect shadow;
 
-    shadow.setBlurRadius(DROP_SHADOW * 2);
-    shadow.setColor(Qt::black);
-    shadow.setOffset(DROP_SHADOW_BLUR, DROP_SHADOW_BLUR);
+bool
+OfficeWindow::event(QEvent* event)
+{
+    if (event->type() == QEvent::LayoutRequest)
+        updateCaptionHints();
 
-    // Blurs the rectangle and renders it to the pixmap.
-    item.setGraphicsEffect(&shadow);
-    scene.addItem(&item);
-    scene.render(&painter);
-    painter.end();
+    return QWidget::event(event);
+}
+
+
+bool
+OfficeWindow::eventFilter(QObject* watched, QEvent* event)
+{
+    if (event->type() == QEvent::LayoutRequest)
+    {
+        for (const WinCaptionItem& item : m_CaptionItems)
+        {
+            if (item.embedded && item.widget.data() == watched)
+            {
+                updateCaptionHints();
+                break;
+            }
+        }
+    }
+
+    return QWidget::eventFilter(watched, event);
 }
 
 
@@ -383,76 +767,69 @@ OfficeWindow::repaintTitleBar()
 
 
 void
-OfficeWindow::updateButtonRects()
+OfficeWindow::repaintAccent()
 {
-    const QSize& szClose = m_CloseImage.size();
-    const QSize& szMaxim = m_MaximImage.size();
-    const QSize& szMinim = m_MinimImage.size();
+    QRect borderRect = m_ClientRect.adjusted(0, 0, -1, -1);
+    QRegion region(m_TitleRect);
 
-    // Calculates the initial button position.
-    int paddingX = (isMaximized()) ? WINDOW_BUTTON_X : ICON_POSITION_X;
-    int paddingY = (isMaximized()) ? WINDOW_BUTTON_Y : ICON_POSITION_Y;
-    int initialX = width() - szClose.width() - paddingX;
-    int initialY = paddingY;
+    // The accent is only used by the title bar (including the
+    // window buttons) and the one pixel wide border.
+    region += QRect(borderRect.left(), borderRect.top(), 1, borderRect.height() + 1);
+    region += QRect(borderRect.right(), borderRect.top(), 1, borderRect.height() + 1);
+    region += QRect(borderRect.left(), borderRect.bottom(), borderRect.width() + 1, 1);
 
-    // Calculates the close button rectangle.
-    if (m_HasCloseBtn)
-    {
-        m_CloseRect.setRect(
-                    initialX - 10,
-                    initialY - 8,
-                    szClose.width()  + 20,
-                    szClose.height() + 16);
-        initialX -= (szMaxim.width() + 20);
-    }
+    update(region);
+}
 
-    // Calculates the maximize button rectangle.
-    if (m_HasMaximBtn)
-    {
-        m_MaximRect.setRect(
-                    initialX - 10,
-                    initialY - 8,
-                    szMaxim.width()  + 20,
-                    szMaxim.height() + 16);
-        initialX -= (szMinim.width() + 20);
-    }
 
-    // Calculates the minimize button rectangle.
-    if (m_HasMinimBtn)
-    {
-        m_MinimRect.setRect(
-                    initialX - 10,
-                    initialY - 8,
-                    szMinim.width()  + 20,
-                    szMinim.height() + 16);
-    }
+QColor
+OfficeWindow::currentAccent() const
+{
+    const QColor& target = OfficeAccents::get(m_Accent);
+    auto* clock = OfficeAnimationClock::instance();
+
+    if (!clock->isAttached(const_cast<OfficeWindow*>(this)))
+        return target;
+
+    // Eases in and out of the transition.
+    qreal t = qreal(clock->time() - m_AccentStart) / ACCENT_FADE_TIME;
+    t = qBound(qreal(0), t, qreal(1));
+    t = t * t * (3 - 2 * t);
+
+    return OfficeAccents::blend(m_AccentFrom, target, t);
 }
 
 
 void
-OfficeWindow::updateResizeRects()
+OfficeWindow::updateFrame(WinFrameInputs changed)
 {
-    // Changes the locations of the resize widgets.
-    m_ResizeTopLeft->setGeometry(0, 0, 10, 10);
-    m_ResizeTopRight->setGeometry(width() - 10, 0, 10, 10);
-    m_ResizeBottomRight->setGeometry(width() - 10, height() - 10, 10, 10);
-    m_ResizeBottomLeft->setGeometry(0, height() - 10, 10, 10);
-    m_ResizeTop->setGeometry(10, 0, width() - 20, 10);
-    m_ResizeRight->setGeometry(width() - 10, 10, 10, height() - 20);
-    m_ResizeBottom->setGeometry(10, height() - 10, width() - 20, 10);
-    m_ResizeLeft->setGeometry(0, 10, 10, height() - 20);
+    const WinFrameInputs layout = WinFrameInput::Size | WinFrameInput::Maximized;
+    const WinFrameInputs caption = layout | WinFrameInput::Caption;
+    const WinFrameInputs title = caption | WinFrameInput::Font | WinFrameInput::Title;
+    const WinFrameInputs resizing = WinFrameInput::Maximized | WinFrameInput::Resizable;
+
+    // Recomputes the parts in dependency order: the drag
+    // rect depends on the caption, the title on the drag rect.
+    if (changed & layout)
+        updateFrameRects();
+    if (changed & WinFrameInput::Size)
+        updateResizeRects();
+    if (changed & caption)
+        updateCaptionItems();
+    if (changed & title)
+        invalidateTitle();
+    if (changed & resizing)
+        updateResizeWidgets();
+    if (changed & WinFrameInput::Maximized)
+        updateLayoutPadding();
+}
 
-    // Determines the padding caused by the drop shadow.
-    int dsPadding = (isMaximized()) ? 0 : DROP_SHADOW_PADDING;
-    int dsAdjustm = (isMaximized()) ? DROP_SHADOW_PADDING : 0;
-    int buttonWid = m_CloseRect.width() + m_MaximRect.width() + m_MinimRect.width();
 
-    // Specifies the title dragging rectangle.
-    m_DragRect.setRect(
-                dsPadding,
-                dsPadding,
-                width() - /*MENU*/ buttonWid - dsPadding * 2,
-                TITLE_HEIGHT);
+void
+OfficeWindow::updateFrameRects()
+{
+    // Determines the padding caused by the drop shadow.
+    const int dsPadding = (isMaximized()) ? 0 : DROP_SHADOW_PADDING;
 
     // Specifies the client rectangle.
     m_ClientRect.setRect(
@@ -467,64 +844,213 @@ OfficeWindow::updateResizeRects()
                 dsPadding,
                 width() - dsPadding * 2,
                 TITLE_HEIGHT);
+}
+
+
+void
+OfficeWindow::updateCaptionItems()
+{
+    // Buttons hang from the top right corner of the window.
+    const int paddingX = (isMaximized()) ? WINDOW_BUTTON_X : ICON_POSITION_X;
+    const int paddingY = (isMaximized()) ? WINDOW_BUTTON_Y : ICON_POSITION_Y;
+    const int titleTop = (isMaximized()) ? 0 : DROP_SHADOW_PADDING;
+    const int right = width() - paddingX + 10;
+    int x = right;
+
+    for (auto& item : m_CaptionItems)
+    {
+        if (!item.visible || (item.embedded && item.widget.isNull()))
+        {
+            item.rect = QRect();
+        }
+        else if (item.embedded)
+        {
+            // Centers the widget vertically within the title bar.
+            const QSize hint = item.widget->sizeHint();
+            const int height = qMin(hint.height(), TITLE_HEIGHT - CAPTION_SPACING);
+
+            x -= CAPTION_SPACING + hint.width();
+            item.rect.setRect(x, titleTop + (TITLE_HEIGHT - height) / 2, hint.width(), height);
+            item.widget->setGeometry(item.rect);
+            x -= CAPTION_SPACING;
+        }
+        else
+        {
+            x -= CAPTION_BTN_WIDTH;
+            item.rect.setRect(x, paddingY - 8, CAPTION_BTN_WIDTH, CAPTION_BTN_HEIGHT);
+        }
+    }
+
+    // Maps every column of the caption to the button on it,
+    // which turns hit-testing into a single lookup.
+    m_CaptionBand.setRect(x, paddingY - 8, right - x, CAPTION_BTN_HEIGHT);
+    m_CaptionLookup.fill(-1, m_CaptionBand.width());
+    m_CaptionTracker->setGeometry(m_CaptionBand);
+
+    for (int i = 0; i < m_CaptionItems.size(); ++i)
+    {
+        const WinCaptionItem& item = m_CaptionItems.at(i);
+        if (item.embedded || item.rect.isNull())
+            continue;
+
+        for (int column = item.rect.left(); column <= item.rect.right(); ++column)
+            m_CaptionLookup[column - x] = static_cast<qint16>(i);
+    }
+
+    // The title can be dragged up to the first caption item.
+    m_DragRect.setRect(
+                m_TitleRect.left(),
+                m_TitleRect.top(),
+                m_CaptionBand.left() - m_TitleRect.left(),
+                TITLE_HEIGHT);
+}
 
-    // TODO: Menu
+
+void
+OfficeWindow::updateCaptionHints()
+{
+    // Layout requests of the client area are frequent, hence
+    // the caption is only laid out if a size hint changed.
+    for (const WinCaptionItem& item : m_CaptionItems)
+    {
+        if (!item.embedded || item.rect.isNull() || item.widget.isNull())
+            continue;
+
+        const QSize hint = item.widget->sizeHint();
+        const int height = qMin(hint.height(), TITLE_HEIGHT - CAPTION_SPACING);
+        if (hint.width() != item.rect.width() || height != item.rect.height())
+        {
+            updateFrame(WinFrameInput::Caption);
+            repaintTitleBar();
+            return;
+        }
+    }
+}
+
+
+void
+OfficeWindow::updateResizeRects()
+{
+    if (!m_Features.testFlag(WinFrameFeature::Resizing))
+        return;
+
+    // Changes the locations of the resize widgets.
+    m_ResizeTopLeft->setGeometry(0, 0, 10, 10);
+    m_ResizeTopRight->setGeometry(width() - 10, 0, 10, 10);
+    m_ResizeBottomRight->setGeometry(width() - 10, height() - 10, 10, 10);
+    m_ResizeBottomLeft->setGeometry(0, height() - 10, 10, 10);
+    m_ResizeTop->setGeometry(10, 0, width() - 20, 10);
+    m_ResizeRight->setGeometry(width() - 10, 10, 10, height() - 20);
+    m_ResizeBottom->setGeometry(10, height() - 10, width() - 20, 10);
+    m_ResizeLeft->setGeometry(0, 10, 10, height() - 20);
 }
 
 
 void
 OfficeWindow::updateVisibleTitle()
 {
-    QString title = windowTitle();
+    QOFFICE_TRACE_SCOPE("OfficeWindow::updateVisibleTitle", this);
+    m_TitleDirty = false;
+
+    const QString title = windowTitle();
+    const QString key = QString::number(m_DragRect.width())
+            + QLatin1Char('\x1f') + font().key()
+            + QLatin1Char('\x1f') + title;
+
+    titleCache().m_LastAccess = OfficeMemory::touch();
+    const QString* cached = titleCache().m_Titles.object(key);
+    if (cached != nullptr)
+    {
+        g_TitleHits.add();
+        m_VisibleTitle = *cached;
+        return;
+    }
+
+    g_TitleMisses.add();
     QFontMetrics metrics(font());
 
     // Retrieves the initial and the estimated width.
-    int currentWidth = metrics.width(title);
-    int estimated = ((m_DragRect.width() - currentWidth) / 2)
-                  - TITLE_PADDING_X - DROP_SHADOW_PADDING;
-
-    // Iterates until the desired with was reached.
-    while (currentWidth > estimated && estimated > 0)
+    const int fullWidth = metrics.width(title);
+    const int estimated = ((m_DragRect.width() - fullWidth) / 2)
+                        - TITLE_PADDING_X - DROP_SHADOW_PADDING;
+
+    // Bisects the longest prefix that fits, as the
+    // width only grows with the length of the prefix.
+    int length = title.length();
+    if (fullWidth > estimated && estimated > 0)
     {
-        title.remove(title.length() - 1, 1);
-        currentWidth = metrics.width(title);
+        int low = 0;
+        int high = title.length() - 1;
+
+        while (low < high)
+        {
+            const int mid = (low + high + 1) / 2;
+            if (metrics.width(title.left(mid)) <= estimated)
+                low = mid;
+            else
+                high = mid - 1;
+        }
+
+        length = low;
     }
 
     // Displays dots behind the modified title.
-    if (title.length() < 3 || estimated < currentWidth)
-        title = QString("");
-    else if (windowTitle().length() != title.length())
-        title.remove(title.length() - 2, 2).append("...");
+    QString visible = title.left(length);
+    if (visible.length() < 3 || estimated < metrics.width(visible))
+        visible = QString("");
+    else if (length != title.length())
+        visible.remove(visible.length() - 2, 2).append("...");
+
+    const int cost = (key.size() + visible.size()) * sizeof(QChar);
+    titleCache().m_Titles.insert(key, new QString(visible), cost);
+    OfficeMemory::commit(&titleCache());
+
+    m_VisibleTitle = visible;
+}
+
+
+void
+OfficeWindow::invalidateTitle()
+{
+    if (m_TitleDirty)
+        g_TitleCoalesced.add();
+
+    m_TitleDirty = true;
+}
+
+
+QRect
+OfficeWindow::titleTextBounds(int textWidth) const
+{
+    // The title is centered on the title bar, not on the
+    // drag area, and is antialiased beyond its advance.
+    const int center = m_TitleRect.center().x();
+    const int half = textWidth / 2 + 2;
 
-    m_VisibleTitle = title;
+    return QRect(center - half, m_TitleRect.top(), half * 2 + 1, TITLE_HEIGHT) & m_TitleRect;
 }
 
 
 void
 OfficeWindow::updateResizeWidgets()
 {
-    if (!m_CanResize || isMaximized())
-    {
-        if (m_ResizeTopLeft->isVisible()) m_ResizeTopLeft->hide();
-        if (m_ResizeTopRight->isVisible()) m_ResizeTopRight->hide();
-        if (m_ResizeBottomRight->isVisible()) m_ResizeBottomRight->hide();
-        if (m_ResizeBottomLeft->isVisible()) m_ResizeBottomLeft->hide();
-        if (m_ResizeTop->isVisible()) m_ResizeTop->hide();
-        if (m_ResizeLeft->isVisible()) m_ResizeLeft->hide();
-        if (m_ResizeBottom->isVisible()) m_ResizeBottom->hide();
-        if (m_ResizeRight->isVisible()) m_ResizeRight->hide();
-    }
-    else
-    {
-        if (!m_ResizeTopLeft->isVisible()) m_ResizeTopLeft->show();
-        if (!m_ResizeTopRight->isVisible()) m_ResizeTopRight->show();
-        if (!m_ResizeBottomRight->isVisible()) m_ResizeBottomRight->show();
-        if (!m_ResizeBottomLeft->isVisible()) m_ResizeBottomLeft->show();
-        if (!m_ResizeTop->isVisible()) m_ResizeTop->show();
-        if (!m_ResizeLeft->isVisible()) m_ResizeLeft->show();
-        if (!m_ResizeBottom->isVisible()) m_ResizeBottom->show();
-        if (!m_ResizeRight->isVisible()) m_ResizeRight->show();
-    }
+    if (!m_Features.testFlag(WinFrameFeature::Resizing))
+        return;
+
+    // Tests the explicit visibility, as every child of a
+    // window that has not been shown yet is invisible.
+    const bool visible = m_CanResize && !isMaximized();
+    if (m_ResizeTop->isHidden() != visible)
+        return;
+
+    m_ResizeTopLeft->setVisible(visible);
+    m_ResizeTopRight->setVisible(visible);
+    m_ResizeBottomRight->setVisible(visible);
+    m_ResizeBottomLeft->setVisible(visible);
+    m_ResizeTop->setVisible(visible);
+    m_ResizeLeft->setVisible(visible);
+    m_ResizeBottom->setVisible(visible);
+    m_ResizeRight->setVisible(visible);
 }
 
 
@@ -532,25 +1058,26 @@ void
 OfficeWindow::updateLayoutPadding()
 {
     QLayout* winLayout = layout();
+    if (winLayout == nullptr)
+        return;
 
-    // No drop shadow in maximized mode.
-    if (isMaximized())
+    // The frame layout moves its content without invalidating it.
+    auto* frameLayout = dynamic_cast<OfficeWindowLayout*>(winLayout);
+    if (frameLayout != nullptr)
     {
-        winLayout->setContentsMargins(1, TITLE_HEIGHT, 1, 1);
-    }
-    else
-    {
-        winLayout->setContentsMargins(
-                    DROP_SHADOW_PADDING + 1,
-                    TITLE_HEIGHT + DROP_SHADOW_PADDING,
-                    DROP_SHADOW_PADDING + 1,
-                    DROP_SHADOW_PADDING + 1);
+        frameLayout->setMaximized(isMaximized());
+        return;
     }
+
+    // Any other layout is invalidated by new margins.
+    const QMargins margins = OfficeWindowLayout::frameMargins(isMaximized());
+    if (winLayout->contentsMargins() != margins)
+        winLayout->setContentsMargins(margins);
 }
 
 
 QRect
-OfficeWindow::centerRect(const QPixmap& img, const QRect& rc)
+OfficeWindow::centerRect(const QSize& img, const QRect& rc)
 {
     int dx = (rc.width()  - img.width())  / 2;
     int dy = (rc.height() - img.height()) / 2;
@@ -574,11 +1101,9 @@ OfficeWindow::mouseMoveDrag(const QPoint& p)
         if (isMaximized())
         {
             // Resets the window position on dragging.
-            m_MaximState = WinButtonState::None;
+            setCaptionHot(-1, WinButtonState::None);
             m_State = WindowState::None;
             showNormal();
-            updateLayoutPadding();
-            updateResizeRects();
         }
         else
         {
@@ -594,91 +1119,26 @@ OfficeWindow::mouseMoveDrag(const QPoint& p)
 }
 
 
-bool
-OfficeWindow::mouseMoveSpecial(const QPoint& p)
+void
+OfficeWindow::mouseMoveCaption(const QPoint& p)
 {
-    // Switches from special state to pressed state.
-    if (m_CloseState == WinButtonState::Special && m_CloseRect.contains(p))
-    {
-        m_CloseState = WinButtonState::Pressed;
-        return true;
-    }
-    else if (m_MaximState == WinButtonState::Special && m_MaximRect.contains(p))
-    {
-        m_MaximState = WinButtonState::Pressed;
-        return true;
-    }
-    else if (m_MinimState == WinButtonState::Special && m_MinimRect.contains(p))
-    {
-        m_MinimState = WinButtonState::Pressed;
-        return true;
-    }
+    const int hit = captionHitTest(p);
 
-    // Switches from pressed state to special state.
-    if (m_CloseState == WinButtonState::Pressed && !m_CloseRect.contains(p))
-    {
-        m_CloseState = WinButtonState::Special;
-        return true;
-    }
-    else if (m_MaximState == WinButtonState::Pressed && !m_MaximRect.contains(p))
-    {
-        m_MaximState = WinButtonState::Special;
-        return true;
-    }
-    else if (m_MinimState == WinButtonState::Pressed && !m_MinimRect.contains(p))
+    switch (m_CaptionState)
     {
-        m_MinimState = WinButtonState::Special;
-        return true;
+    case WinButtonState::Pressed:
+        // Leaving a pressed item arms it until it is entered again.
+        if (hit != m_CaptionHot)
+            setCaptionHot(m_CaptionHot, WinButtonState::Special);
+        break;
+    case WinButtonState::Special:
+        if (hit == m_CaptionHot)
+            setCaptionHot(m_CaptionHot, WinButtonState::Pressed);
+        break;
+    default:
+        setCaptionHot(hit, WinButtonState::Hovered);
+        break;
     }
-
-    return false;
-}
-
-
-bool
-OfficeWindow::mouseMoveHitTest(const QPoint& p)
-{
-    // Changes the button into hovered state if
-    // the mouse pointer happens to hover it.
-    if (m_CloseState != WinButtonState::Pressed &&
-        m_CloseState != WinButtonState::Special &&
-        m_MaximState != WinButtonState::Pressed &&
-        m_MaximState != WinButtonState::Special &&
-        m_MinimState != WinButtonState::Pressed &&
-        m_MinimState != WinButtonState::Special)
-    {
-        // Determines whether one button has been hovered before.
-        // If yes, do not perform a repaint of the title bar.
-        bool initial = m_CloseState != WinButtonState::Hovered &&
-                       m_MaximState != WinButtonState::Hovered &&
-                       m_MinimState != WinButtonState::Hovered ;
-
-        // Resets all current states.
-        m_CloseState = WinButtonState::None;
-        m_MaximState = WinButtonState::None;
-        m_MinimState = WinButtonState::None;
-
-        // Determines whether there is any new state.
-        if (m_HasCloseBtn && m_CloseRect.contains(p))
-        {
-            m_CloseState = WinButtonState::Hovered;
-            return true;
-        }
-        else if (m_HasMaximBtn && m_MaximRect.contains(p))
-        {
-            m_MaximState = WinButtonState::Hovered;
-            return true;
-        }
-        else if (m_HasMinimBtn && m_MinimRect.contains(p))
-        {
-            m_MinimState = WinButtonState::Hovered;
-            return true;
-        }
-
-        return initial;
-    }
-
-    return false;
 }
 
 
@@ -698,38 +1158,10 @@ OfficeWindow::mousePressDrag(const QPoint& p)
 }
 
 
-bool
-OfficeWindow::mousePressHitTest(const QPoint& p)
+void
+OfficeWindow::mousePressCaption(const QPoint& p)
 {
-    // Determines whether one button has been pressed before.
-    // If yes, do not perform a repaint of the title bar.
-    bool initial = m_CloseState != WinButtonState::Pressed &&
-                   m_MaximState != WinButtonState::Pressed &&
-                   m_MinimState != WinButtonState::Pressed ;
-
-    // Resets all the current states.
-    m_CloseState = WinButtonState::None;
-    m_MaximState = WinButtonState::None;
-    m_MinimState = WinButtonState::None;
-
-    // Determines whether there is any new state.
-    if (m_HasCloseBtn && m_CloseRect.contains(p))
-    {
-        m_CloseState = WinButtonState::Pressed;
-        return true;
-    }
-    else if (m_HasMaximBtn && m_MaximRect.contains(p))
-    {
-        m_MaximState = WinButtonState::Pressed;
-        return true;
-    }
-    else if (m_HasMinimBtn && m_MinimRect.contains(p))
-    {
-        m_MinimState = WinButtonState::Pressed;
-        return true;
-    }
-
-    return initial;
+    setCaptionHot(captionHitTest(p), WinButtonState::Pressed);
 }
 
 
@@ -746,52 +1178,89 @@ OfficeWindow::mouseReleaseDrag(const QPoint&)
 }
 
 
-bool
-OfficeWindow::mouseReleaseAction(const QPoint& p)
+void
+OfficeWindow::mouseReleaseCaption(const QPoint& p)
 {
-    if (m_CloseState == WinButtonState::Pressed ||
-        m_CloseState == WinButtonState::Special ||
-        m_MaximState == WinButtonState::Pressed ||
-        m_MaximState == WinButtonState::Special ||
-        m_MinimState == WinButtonState::Pressed ||
-        m_MinimState == WinButtonState::Special)
+    if (m_CaptionState != WinButtonState::Pressed &&
+        m_CaptionState != WinButtonState::Special)
+        return;
+
+    // Only triggers items that are released where they were pressed.
+    const int index = m_CaptionHot;
+    const bool trigger = m_CaptionState == WinButtonState::Pressed &&
+                         captionHitTest(p) == index;
+
+    setCaptionHot(-1, WinButtonState::None);
+    if (trigger)
+        triggerCaptionItem(index);
+}
+
+
+void
+OfficeWindow::triggerCaptionItem(int index)
+{
+    const int id = m_CaptionItems.at(index).id;
+
+    switch (id)
     {
-        // Executes certain actions based on the clicked button.
-        if (m_CloseState == WinButtonState::Pressed && m_CloseRect.contains(p))
-        {
-            close();
-        }
-        else if (m_MaximState == WinButtonState::Pressed && m_MaximRect.contains(p))
-        {
-            if (isMaximized())
-            {
-                showNormal();
-                updateResizeRects();
-            }
-            else
-            {
-                showMaximized();
-                updateResizeRects();
-            }
+    case CaptionClose:
+        close();
+        break;
+    case CaptionMaximize:
+        if (isMaximized())
+            showNormal();
+        else
+            showMaximized();
+        break;
+    case CaptionMinimize:
+        showMinimized();
+        break;
+    default:
+        emit captionButtonClicked(id);
+        break;
+    }
+}
 
-            updateLayoutPadding();
-            update();
-        }
-        else if (m_MinimState == WinButtonState::Pressed && m_MinimRect.contains(p))
-        {
-            showMinimized();
-            updateLayoutPadding();
-        }
 
-        // Resets all the pressed states.
-        m_CloseState = WinButtonState::None;
-        m_MaximState  = WinButtonState::None;
-        m_MinimState  = WinButtonState::None;
+void
+OfficeWindow::setCaptionHot(int index, WinButtonState state)
+{
+    if (index < 0)
+        state = WinButtonState::None;
+    if (index == m_CaptionHot && state == m_CaptionState)
+        return;
 
-        return true;
+    // Repaints only the items whose highlight changes.
+    if (m_CaptionHot >= 0)
+        update(m_CaptionItems.at(m_CaptionHot).rect);
+    if (index >= 0 && index != m_CaptionHot)
+        update(m_CaptionItems.at(index).rect);
+
+    m_CaptionHot = index;
+    m_CaptionState = state;
+}
+
+
+int
+OfficeWindow::captionHitTest(const QPoint& p) const
+{
+    if (!m_CaptionBand.contains(p))
+        return -1;
+
+    return m_CaptionLookup.at(p.x() - m_CaptionBand.left());
+}
+
+
+int
+OfficeWindow::captionIndex(int id) const
+{
+    for (int i = 0; i < m_CaptionItems.size(); ++i)
+    {
+        if (m_CaptionItems.at(i).id == id)
+            return i;
     }
 
-    return false;
+    return -1;
 }
 
 
@@ -832,17 +1301,15 @@ WinResizeArea::WinResizeArea(OfficeWindow* window, WinResizeDirs dir)
 void
 WinResizeArea::enterEvent(QEvent*)
 {
-    m_Window->m_CloseState = WinButtonState::None;
-    m_Window->m_MaximState = WinButtonState::None;
-    m_Window->m_MinimState = WinButtonState::None;
-    m_Window->repaintTitleBar();
+    if (m_Window->m_CaptionState == WinButtonState::Hovered)
+        m_Window->setCaptionHot(-1, WinButtonState::None);
 }
 
 
 void
 WinResizeArea::mousePressEvent(QMouseEvent* event)
 {
-    if (event->button() == Qt::LeftButton && m_Window->canResize())
+    if (event->button() == Qt::LeftButton && m_Window->canResize() && !m_Window->isMaximized())
         m_Window->m_State = WindowState::Resizing;
 }
 
@@ -853,7 +1320,6 @@ WinResizeArea::mouseReleaseEvent(QMouseEvent* event)
     if (event->button() == Qt::LeftButton && m_Window->canResize())
     {
         m_Window->m_State = WindowState::None;
-        m_Window->generateDropShadow();
         m_Window->update();
     }
 }
@@ -895,3 +1361,54 @@ WinResizeArea::mouseMoveEvent(QMouseEvent* event)
         m_Window->setGeometry(r);
     }
 }
+
+
+WinCaptionTracker::WinCaptionTracker(OfficeWindow* window)
+    : QWidget(window)
+    , m_Window(window)
+{
+    setMouseTracking(true);
+
+    // Keeps embedded widgets and resizing areas on top.
+    lower();
+}
+
+
+void
+WinCaptionTracker::mouseMoveEvent(QMouseEvent* event)
+{
+    QOFFICE_TRACE_SCOPE("WinCaptionTracker::mouseMoveEvent", m_Window);
+    g_HoverMoves.add();
+
+    m_Window->mouseMoveCaption(mapToParent(event->pos()));
+}
+
+
+void
+WinCaptionTracker::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton)
+        m_Window->mousePressCaption(mapToParent(event->pos()));
+}
+
+
+void
+WinCaptionTracker::mouseReleaseEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton)
+        m_Window->mouseReleaseCaption(mapToParent(event->pos()));
+}
+
+
+void
+WinCaptionTracker::mouseDoubleClickEvent(QMouseEvent*)
+{
+}
+
+
+void
+WinCaptionTracker::leaveEvent(QEvent*)
+{
+    if (m_Window->m_CaptionState == WinButtonState::Hovered)
+        m_Window->setCaptionHot(-1, WinButtonState::None);
+}
@@ -0,0 +1,181 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Widgets/OfficeWindowLayout.hpp>
+#include <QOffice/Widgets/Constants/OfficeWindowConstants.hpp>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+/**
+ * Adds the given margins to a size, leaving
+ * QWIDGETSIZE_MAX untouched.
+ *
+ */
+static QSize expandedBy(const QSize& size, const QMargins& margins)
+{
+    const int w = size.width() + margins.left() + margins.right();
+    const int h = size.height() + margins.top() + margins.bottom();
+
+    return QSize(qMin(w, QWIDGETSIZE_MAX), qMin(h, QWIDGETSIZE_MAX));
+}
+
+
+OfficeWindowLayout::OfficeWindowLayout(QWidget* parent)
+    : QLayout(parent)
+    , m_Content(nullptr)
+    , m_Maximized(false)
+{
+    setContentsMargins(0, 0, 0, 0);
+}
+
+
+OfficeWindowLayout::~OfficeWindowLayout()
+{
+    delete m_Content;
+}
+
+
+QMargins
+OfficeWindowLayout::frameMargins(bool maximized)
+{
+    // No drop shadow in maximized mode.
+    if (maximized)
+        return QMargins(1, TITLE_HEIGHT, 1, 1);
+
+    return QMargins(
+            DROP_SHADOW_PADDING + 1,
+            TITLE_HEIGHT + DROP_SHADOW_PADDING,
+            DROP_SHADOW_PADDING + 1,
+            DROP_SHADOW_PADDING + 1);
+}
+
+
+bool
+OfficeWindowLayout::isMaximized() const
+{
+    return m_Maximized;
+}
+
+
+void
+OfficeWindowLayout::setMaximized(bool maximized)
+{
+    if (m_Maximized == maximized)
+        return;
+
+    // The size hints of the content do not depend on the
+    // frame, therefore the content is only moved.
+    m_Maximized = maximized;
+    if (geometry().isValid())
+        setGeometry(geometry());
+}
+
+
+void
+OfficeWindowLayout::setContentLayout(QLayout* layout)
+{
+    addChildLayout(layout);
+    addItem(layout);
+}
+
+
+void
+OfficeWindowLayout::addItem(QLayoutItem* item)
+{
+    delete m_Content;
+    m_Content = item;
+    invalidate();
+}
+
+
+int
+OfficeWindowLayout::count() const
+{
+    return (m_Content != nullptr) ? 1 : 0;
+}
+
+
+QLayoutItem*
+OfficeWindowLayout::itemAt(int index) const
+{
+    return (index == 0) ? m_Content : nullptr;
+}
+
+
+QLayoutItem*
+OfficeWindowLayout::takeAt(int index)
+{
+    if (index != 0 || m_Content == nullptr)
+        return nullptr;
+
+    QLayoutItem* content = m_Content;
+    m_Content = nullptr;
+    invalidate();
+
+    return content;
+}
+
+
+QSize
+OfficeWindowLayout::sizeHint() const
+{
+    const QSize content = (m_Content != nullptr) ? m_Content->sizeHint() : QSize(0, 0);
+    return expandedBy(content, frameMargins(false));
+}
+
+
+QSize
+OfficeWindowLayout::minimumSize() const
+{
+    const QSize content = (m_Content != nullptr) ? m_Content->minimumSize() : QSize(0, 0);
+    return expandedBy(content, frameMargins(false));
+}
+
+
+QSize
+OfficeWindowLayout::maximumSize() const
+{
+    if (m_Content == nullptr)
+        return QSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
+
+    return expandedBy(m_Content->maximumSize(), frameMargins(false));
+}
+
+
+Qt::Orientations
+OfficeWindowLayout::expandingDirections() const
+{
+    return (m_Content != nullptr) ? m_Content->expandingDirections() : Qt::Orientations();
+}
+
+
+void
+OfficeWindowLayout::setGeometry(const QRect& rect)
+{
+    QLayout::setGeometry(rect);
+
+    if (m_Content != nullptr)
+        m_Content->setGeometry(rect.marginsRemoved(frameMargins(m_Maximized)));
+}
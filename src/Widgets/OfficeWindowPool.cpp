@@ -0,0 +1,239 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Widgets/OfficeWindowPool.hpp>
+#include <QOffice/Widgets/OfficeWindow.hpp>
+#include <QOffice/Widgets/OfficeResourceContext.hpp>
+#include <QOffice/Design/OfficeIdleScheduler.hpp>
+#include <QOffice/Diagnostics/OfficeCounters.hpp>
+
+// Qt headers
+#include <QApplication>
+#include <QPointer>
+#include <QTimer>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+// Performance counters
+static OfficeCounter g_PoolHits("pool.hits");
+static OfficeCounter g_PoolMisses("pool.misses");
+static OfficeCounter g_PoolRecycled("pool.recycled");
+
+
+OfficeWindowPool::OfficeWindowPool(int capacity, Factory factory, QObject* parent)
+    : QObject(parent)
+    , m_Factory(factory)
+    , m_Capacity(qMax(0, capacity))
+{
+    scheduleFill();
+}
+
+
+OfficeWindowPool::~OfficeWindowPool()
+{
+    OfficeIdleScheduler::instance()->cancelAll(this);
+    qDeleteAll(m_Windows);
+}
+
+
+int
+OfficeWindowPool::capacity() const
+{
+    return m_Capacity;
+}
+
+
+int
+OfficeWindowPool::available() const
+{
+    return m_Windows.size();
+}
+
+
+void
+OfficeWindowPool::setCapacity(int capacity)
+{
+    m_Capacity = qMax(0, capacity);
+    while (m_Windows.size() > m_Capacity)
+        delete m_Windows.takeLast();
+
+    scheduleFill();
+}
+
+
+void
+OfficeWindowPool::setRecycler(Recycler recycler)
+{
+    m_Recycler = recycler;
+}
+
+
+OfficeWindow*
+OfficeWindowPool::acquire()
+{
+    OfficeWindow* window;
+    if (m_Windows.isEmpty())
+    {
+        g_PoolMisses.add();
+        window = create();
+    }
+    else
+    {
+        g_PoolHits.add();
+        window = m_Windows.takeFirst();
+    }
+
+    // Refills the pool after the window has been shown.
+    window->installEventFilter(this);
+    scheduleFill();
+
+    return window;
+}
+
+
+void
+OfficeWindowPool::release(OfficeWindow* window)
+{
+    window->removeEventFilter(this);
+    if (m_Windows.contains(window))
+        return;
+
+    if (m_Windows.size() >= m_Capacity)
+    {
+        window->deleteLater();
+        return;
+    }
+
+    window->hide();
+    window->setWindowState(Qt::WindowNoState);
+
+    // Restores the frame the factory has built. Windows
+    // acquired from another pool are left as they are.
+    auto it = m_Frames.constFind(window);
+    if (it != m_Frames.constEnd())
+    {
+        const FrameState& frame = it.value();
+        window->setWindowTitle(frame.title);
+        window->setAccentAnimated(false);
+        window->setAccent(frame.accent);
+        window->setAccentAnimated(frame.accentAnimated);
+        window->clearCaptionItems(frame.captionItems);
+
+        for (int i = 0; i < frame.captionItems.size(); ++i)
+            window->setCaptionItemVisible(frame.captionItems.at(i), frame.captionVisible.at(i));
+
+        window->setCloseButtonVisible(frame.closeButton);
+        window->setMaximizeButtonVisible(frame.maximizeButton);
+        window->setMinimizeButtonVisible(frame.minimizeButton);
+        window->setResizable(frame.resizable);
+    }
+
+    if (m_Recycler)
+        m_Recycler(window);
+
+    m_Windows.append(window);
+    g_PoolRecycled.add();
+}
+
+
+bool
+OfficeWindowPool::eventFilter(QObject* watched, QEvent* event)
+{
+    if (event->type() == QEvent::Close)
+    {
+        // The window might refuse to close, therefore it
+        // is only recycled once it has actually been hidden.
+        QPointer<OfficeWindow> window = static_cast<OfficeWindow*>(watched);
+        QTimer::singleShot(0, this, [this, window] () {
+            if (!window.isNull() && !window->isVisible())
+                release(window);
+        });
+    }
+
+    return false;
+}
+
+
+OfficeWindow*
+OfficeWindowPool::create()
+{
+    OfficeWindow* window = (m_Factory) ? m_Factory() : new OfficeWindow;
+
+    // Does everything that does not require the window to be shown.
+    window->ensurePolished();
+    window->winId();
+
+    // Remembers the frame, so that recycling can restore it.
+    FrameState frame;
+    frame.title = window->windowTitle();
+    frame.accent = window->accent();
+    frame.accentAnimated = window->isAccentAnimated();
+    frame.closeButton = window->hasCloseButton();
+    frame.maximizeButton = window->hasMaximizeButton();
+    frame.minimizeButton = window->hasMinimizeButton();
+    frame.resizable = window->canResize();
+    frame.captionItems = window->captionItems();
+
+    for (int id : frame.captionItems)
+        frame.captionVisible.append(window->isCaptionItemVisible(id));
+
+    m_Frames.insert(window, frame);
+    connect(window, &QObject::destroyed, this, [this, window] () {
+        m_Frames.remove(window);
+    });
+
+    // Keeps the shared frame assets alive and rasterized.
+    if (m_Resources.isNull())
+    {
+        m_Resources = OfficeResourceContext::acquire(window->devicePixelRatioF());
+        m_Resources->dropShadow();
+        for (int i = 0; i < OfficeGlyphs::Max; ++i)
+            m_Resources->glyph(static_cast<OfficeGlyphs::Glyph>(i));
+    }
+
+    return window;
+}
+
+
+void
+OfficeWindowPool::scheduleFill()
+{
+    if (m_Windows.size() >= m_Capacity)
+        return;
+
+    OfficeIdleScheduler::instance()->schedule(
+        this, "OfficeWindowPool::fill", OfficeIdleScheduler::Low, [this] () { fill(); });
+}
+
+
+void
+OfficeWindowPool::fill()
+{
+    // Builds one window per task to keep the event loop responsive.
+    if (m_Windows.size() < m_Capacity)
+        m_Windows.append(create());
+
+    scheduleFill();
+}
@@ -0,0 +1,28 @@
+###########################################################
+#
+#   QOffice: Office UI framework for Qt
+#   Copyright (C) 2016-2017 Nicolas Kogler
+#   License: Lesser General Public License 3.0
+#
+###########################################################
+
+###########################################################
+#
+# QMAKE SETTINGS
+#
+# Runs without a display if QT_QPA_PLATFORM=offscreen.
+###########################################################
+TARGET          =       QOfficeFrameTest
+TEMPLATE        =       app
+QT             +=       widgets
+CONFIG         +=       console testcase
+CONFIG         -=       app_bundle
+
+include(../library.pri)
+include(../harness/harness.pri)
+
+###########################################################
+#
+# SOURCE FILES
+###########################################################
+SOURCES             +=      main.cpp
@@ -0,0 +1,197 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Widgets/OfficeWindow.hpp>
+#include <QOffice/Diagnostics/OfficeMemory.hpp>
+
+// Harness headers
+#include "OfficeIdleProbe.hpp"
+#include "OfficeInputRecorder.hpp"
+#include "OfficeStressTest.hpp"
+
+// Qt headers
+#include <QApplication>
+#include <QBuffer>
+#include <QLabel>
+#include <QVBoxLayout>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+#define TEST_WINDOW_WIDTH   480     ///< Width of the windows under test
+#define TEST_WINDOW_HEIGHT  320     ///< Height of the windows under test
+#define TEST_STRESS_STEPS   100000  ///< Random steps of the stress test
+#define TEST_STRESS_SEED    42      ///< Seed of the stress test
+#define TEST_MEMORY_BUDGET  1024    ///< Cache memory budget of the stress test, in KB
+#define TEST_MEMORY_GROWTH  64      ///< Tolerated cache growth, the size of the title cache, in KB
+#define TEST_IDLE_DURATION  2000    ///< Idle period of the idle probe, in milliseconds
+
+
+/**
+ * Records a hover across the caption buttons, saves and
+ * loads it, and replays it on a window.
+ *
+ */
+static bool testRecording()
+{
+    OfficeInputRecording recording;
+    recording.setWindowSize(QSize(TEST_WINDOW_WIDTH, TEST_WINDOW_HEIGHT));
+
+    for (int x = 0; x < TEST_WINDOW_WIDTH; x += 8)
+    {
+        OfficeInputEvent event;
+        event.delay = 1000;
+        event.type = OfficeInputEvent::Move;
+        event.button = Qt::NoButton;
+        event.buttons = Qt::NoButton;
+        event.modifiers = 0;
+        event.pos = QPoint(x, 20);
+        recording.append(event);
+    }
+
+    // The binary format must survive a round trip.
+    QBuffer buffer;
+    OfficeInputRecording loaded;
+    buffer.open(QBuffer::ReadWrite);
+
+    if (!recording.save(&buffer) || !buffer.seek(0) || !loaded.load(&buffer))
+    {
+        qWarning("recording: could not save or load the recording");
+        return false;
+    }
+    if (loaded.windowSize() != recording.windowSize() ||
+        loaded.events().size() != recording.events().size() ||
+        loaded.events().last().pos != recording.events().last().pos)
+    {
+        qWarning("recording: the loaded recording differs");
+        return false;
+    }
+
+    OfficeWindow window;
+    auto result = OfficeInputReplayer::replay(loaded, &window, false);
+    if (result.events.count() != quint64(loaded.events().size()))
+    {
+        qWarning("recording: %llu of %d events were replayed",
+                 result.events.count(),
+                 loaded.events().size());
+        return false;
+    }
+
+    qInfo("recording: %d events replayed, p99 frame %lld ns",
+          loaded.events().size(),
+          result.frames.percentile(0.99));
+
+    return true;
+}
+
+
+/**
+ * Drives a window with random input and checks the
+ * invariants of its frame after every step.
+ *
+ */
+static bool testStress()
+{
+    QImage icon(16, 16, QImage::Format_ARGB32_Premultiplied);
+    icon.fill(Qt::white);
+
+    OfficeWindow window;
+    window.resize(TEST_WINDOW_WIDTH, TEST_WINDOW_HEIGHT);
+    window.addCaptionButton(icon);
+
+    const qint64 budget = OfficeMemory::budget();
+    OfficeMemory::setBudget(TEST_MEMORY_BUDGET * 1024);
+
+    auto result = OfficeStressTest::run(&window, TEST_STRESS_STEPS, TEST_STRESS_SEED);
+    OfficeMemory::setBudget(budget);
+
+    for (const QString& message : result.messages)
+        qWarning("stress: %s", qPrintable(message));
+
+    qInfo("stress: %llu steps, p99 %lld ns, memory %lld -> %lld bytes, peak %lld bytes",
+          result.steps,
+          result.latency.percentile(0.99),
+          result.memoryStart,
+          result.memoryEnd,
+          result.memoryPeak);
+
+    // The caches are bounded, so a long run must not grow them.
+    bool passed = result.passed();
+    if (result.memoryPeak > TEST_MEMORY_BUDGET * 1024)
+    {
+        qWarning("stress: the peak cache memory exceeds the budget");
+        passed = false;
+    }
+    if (result.memoryEnd > result.memoryStart + TEST_MEMORY_GROWTH * 1024)
+    {
+        qWarning("stress: the cache memory has grown by more than %d KB", TEST_MEMORY_GROWTH);
+        passed = false;
+    }
+
+    return passed;
+}
+
+
+/**
+ * Shows a window with typical content and verifies that
+ * it causes no activity while nothing happens.
+ *
+ */
+static bool testIdle()
+{
+    OfficeWindow window;
+    window.resize(TEST_WINDOW_WIDTH, TEST_WINDOW_HEIGHT);
+    window.setWindowTitle("Idle");
+
+    auto layout = new QVBoxLayout(&window);
+    layout->addWidget(new QLabel("Nothing happens here."));
+    layout->addStretch();
+
+    auto result = OfficeIdleProbe::run(&window, TEST_IDLE_DURATION);
+    for (auto it = result.sources.begin(); it != result.sources.end(); ++it)
+        qWarning("idle: %llu x %s", it.value(), qPrintable(it.key()));
+
+    qInfo("idle: %llu wakeups, %lld us cpu time in %lld ms",
+          result.wakeups,
+          result.cpuTime,
+          result.duration);
+
+    return result.passed();
+}
+
+
+int main(int argc, char* argv[])
+{
+    QApplication app(argc, argv);
+    int failures = 0;
+
+    if (!testRecording())
+        failures++;
+    if (!testStress())
+        failures++;
+    if (!testIdle())
+        failures++;
+
+    return failures;
+}
@@ -0,0 +1,207 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include "OfficeIdleProbe.hpp"
+#include <QOffice/Widgets/OfficeWindow.hpp>
+
+// Qt headers
+#include <QAbstractEventDispatcher>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QThread>
+#include <QTimer>
+
+// Platform headers
+#if defined(Q_OS_WIN)
+    #include <windows.h>
+#elif defined(Q_OS_UNIX)
+    #include <sys/resource.h>
+#endif
+
+
+QOFFICE_USING_NAMESPACE
+
+
+#define IDLE_CPU_TOLERANCE  1000    ///< CPU time that counts as zero, in microseconds
+
+
+/**
+ * Retrieves the CPU time used by all threads of the
+ * process so far, in microseconds.
+ *
+ */
+static qint64 processCpuTime()
+{
+#if defined(Q_OS_WIN)
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        return 0;
+
+    // Both times are given in units of 100 nanoseconds.
+    ULARGE_INTEGER k, u;
+    k.LowPart = kernel.dwLowDateTime;
+    k.HighPart = kernel.dwHighDateTime;
+    u.LowPart = user.dwLowDateTime;
+    u.HighPart = user.dwHighDateTime;
+
+    return static_cast<qint64>(k.QuadPart + u.QuadPart) / 10;
+#elif defined(Q_OS_UNIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+    return (qint64(usage.ru_utime.tv_sec) + usage.ru_stime.tv_sec) * 1000000
+         + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+#else
+    return 0;
+#endif
+}
+
+
+/**
+ * Lets the event loop run for the given time.
+ *
+ */
+static void runEventLoop(int msecs)
+{
+    QEventLoop loop;
+    QTimer::singleShot(msecs, &loop, SLOT(quit()));
+    loop.exec();
+}
+
+
+/**
+ * Counts all events delivered within the GUI thread,
+ * except for the ones of the timer ending the period.
+ *
+ */
+class IdleFilter : public QObject
+{
+public:
+
+    IdleFilter(OfficeIdleResult* result, const QObject* ignored)
+        : m_Result(result)
+        , m_Ignored(ignored)
+    {
+    }
+
+protected:
+
+    bool eventFilter(QObject* watched, QEvent* event) override
+    {
+        if (watched == m_Ignored)
+            return false;
+
+        switch (event->type())
+        {
+        case QEvent::Timer:
+        case QEvent::ZeroTimerEvent:
+            m_Result->timerEvents++;
+            break;
+        case QEvent::Paint:
+        case QEvent::UpdateRequest:
+        case QEvent::UpdateLater:
+            m_Result->paintEvents++;
+            break;
+        default:
+            if (!event->spontaneous())
+                m_Result->postedEvents++;
+            break;
+        }
+
+        // Names the culprit, e.g. "OfficeAnimationClock/1".
+        const QString source = QString("%1/%2")
+                .arg(watched->metaObject()->className())
+                .arg(int(event->type()));
+
+        m_Result->sources[source]++;
+        return false;
+    }
+
+private:
+
+    OfficeIdleResult* m_Result;
+    const QObject* m_Ignored;
+};
+
+
+bool
+OfficeIdleResult::passed() const
+{
+    return wakeups == 0 &&
+           timerEvents == 0 &&
+           paintEvents == 0 &&
+           postedEvents == 0 &&
+           cpuTime <= IDLE_CPU_TOLERANCE;
+}
+
+
+OfficeIdleResult
+OfficeIdleProbe::run(OfficeWindow* window, int duration, int settle)
+{
+    OfficeIdleResult result;
+    auto* dispatcher = QAbstractEventDispatcher::instance(qApp->thread());
+    Q_ASSERT(dispatcher != nullptr);
+    Q_ASSERT(QThread::currentThread() == qApp->thread());
+
+    // Grants showing, polishing and deferred work some time.
+    if (!window->isVisible())
+        window->show();
+
+    runEventLoop(settle);
+    QCoreApplication::sendPostedEvents();
+
+    QTimer end;
+    end.setSingleShot(true);
+    end.setTimerType(Qt::PreciseTimer);
+
+    QEventLoop loop;
+    QObject::connect(&end, SIGNAL(timeout()), &loop, SLOT(quit()));
+
+    IdleFilter filter(&result, &end);
+    auto awake = QObject::connect(
+            dispatcher, &QAbstractEventDispatcher::awake, [&result] () {
+        result.wakeups++;
+    });
+
+    // Watches the idle period.
+    QElapsedTimer elapsed;
+    qApp->installEventFilter(&filter);
+    const qint64 cpuStart = processCpuTime();
+    elapsed.start();
+    end.start(duration);
+
+    loop.exec();
+
+    result.cpuTime = processCpuTime() - cpuStart;
+    result.duration = elapsed.elapsed();
+    qApp->removeEventFilter(&filter);
+    QObject::disconnect(awake);
+
+    // The timer ending the period wakes the event loop, too.
+    if (result.wakeups > 0)
+        result.wakeups--;
+
+    return result;
+}
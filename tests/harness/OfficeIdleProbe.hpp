@@ -0,0 +1,124 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICEIDLEPROBE_HPP
+#define QOFFICE_OFFICEIDLEPROBE_HPP
+
+
+// QOffice headers
+#include <QOffice/Config.hpp>
+
+// Qt headers
+#include <QMap>
+#include <QString>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+// Forward declarations
+class OfficeWindow;
+
+
+/**
+ * Holds the activity observed during an idle period.
+ *
+ * @struct OfficeIdleResult
+ * @author Nicolas Kogler
+ * @date January 19th, 2017
+ *
+ */
+struct OfficeIdleResult
+{
+    qint64 duration = 0;                ///< Length of the idle period, in milliseconds
+    quint64 wakeups = 0;                ///< Times the GUI event loop woke up
+    quint64 timerEvents = 0;            ///< Delivered timer events
+    quint64 paintEvents = 0;            ///< Delivered paint and update requests
+    quint64 postedEvents = 0;           ///< Delivered events not caused by the system
+    qint64 cpuTime = 0;                 ///< CPU time used by the process, in microseconds
+    QMap<QString, quint64> sources;     ///< Events per receiver class and type
+
+    /**
+     * Determines whether the application stayed idle. CPU
+     * time below the resolution of the clocks of common
+     * platforms counts as zero.
+     *
+     * @returns true if the run passed.
+     *
+     */
+    bool passed() const;
+};
+
+
+/**
+ * Verifies that an idle OfficeWindow costs nothing. Shows the
+ * window, lets pending work settle and then watches the GUI
+ * thread for a period in which nothing happens. Every timer,
+ * paint and posted event within that period is a failure,
+ * as is CPU time spent by any thread of the process.
+ *
+ * Any animation, cache or diagnostic must stop its timers
+ * and threads once it has nothing left to do.
+ *
+ * @class OfficeIdleProbe
+ * @author Nicolas Kogler
+ * @date January 19th, 2017
+ *
+ */
+class OfficeIdleProbe
+{
+public:
+
+    /**
+     * Watches the given window while it is idle. Must be
+     * called from within the GUI thread and must not be
+     * called while the mouse pointer is over the window.
+     *
+     * @param window The window, with its typical content.
+     * @param duration The idle period in milliseconds.
+     * @param settle The time granted to pending work.
+     * @returns the activity within the idle period.
+     *
+     */
+    static OfficeIdleResult run(
+            OfficeWindow* window,
+            int duration = 2000,
+            int settle = 500);
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     auto result = OfficeIdleProbe::run(window, 5000);
+ *     if (!result.passed())
+ *         qWarning() << result.sources;
+ * @endcode
+ *
+ */
+
+#endif // QOFFICE_OFFICEIDLEPROBE_HPP
@@ -0,0 +1,325 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include "OfficeInputRecorder.hpp"
+#include <QOffice/Diagnostics/OfficeCounters.hpp>
+#include <QOffice/Widgets/OfficeWindow.hpp>
+
+// Qt headers
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QMouseEvent>
+#include <QScopedPointer>
+#include <QThread>
+#include <QWindow>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+#define RECORDING_MAGIC     0x514F4952  ///< Identifies recordings ('QOIR')
+#define RECORDING_VERSION   1           ///< Version of the binary format
+#define MODIFIER_SHIFT      25          ///< Moves Qt::ShiftModifier to bit 0
+
+
+/**
+ * Retrieves the native window of the given widget
+ * and creates it if necessary.
+ *
+ */
+static QWindow* nativeWindow(QWidget* widget)
+{
+    if (widget->windowHandle() == nullptr)
+        widget->winId();
+
+    return widget->windowHandle();
+}
+
+
+/**
+ * Waits until the given point in time, without
+ * oversleeping by a whole scheduler tick.
+ *
+ */
+static void waitUntil(const QElapsedTimer& clock, qint64 due)
+{
+    qint64 remaining = due - clock.nsecsElapsed();
+    if (remaining > 2000000)
+        QThread::usleep(static_cast<unsigned long>((remaining - 1000000) / 1000));
+
+    while (clock.nsecsElapsed() < due);
+}
+
+
+QSize
+OfficeInputRecording::windowSize() const
+{
+    return m_WindowSize;
+}
+
+
+const QVector<OfficeInputEvent>&
+OfficeInputRecording::events() const
+{
+    return m_Events;
+}
+
+
+void
+OfficeInputRecording::setWindowSize(const QSize& size)
+{
+    m_WindowSize = size;
+}
+
+
+void
+OfficeInputRecording::append(const OfficeInputEvent& event)
+{
+    m_Events.append(event);
+}
+
+
+bool
+OfficeInputRecording::save(QIODevice* device) const
+{
+    QDataStream stream(device);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << quint32(RECORDING_MAGIC)
+           << quint16(RECORDING_VERSION)
+           << qint32(m_WindowSize.width())
+           << qint32(m_WindowSize.height())
+           << quint32(m_Events.size());
+
+    for (const auto& event : m_Events)
+    {
+        stream << event.delay
+               << event.type
+               << event.button
+               << event.buttons
+               << event.modifiers
+               << qint16(event.pos.x())
+               << qint16(event.pos.y());
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+
+bool
+OfficeInputRecording::load(QIODevice* device)
+{
+    QDataStream stream(device);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic, count;
+    quint16 version;
+    qint32 width, height;
+    stream >> magic >> version >> width >> height >> count;
+
+    if (magic != RECORDING_MAGIC || version != RECORDING_VERSION)
+        return false;
+
+    QVector<OfficeInputEvent> events;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+    {
+        OfficeInputEvent event;
+        qint16 x, y;
+
+        stream >> event.delay
+               >> event.type
+               >> event.button
+               >> event.buttons
+               >> event.modifiers
+               >> x
+               >> y;
+
+        if (event.type > OfficeInputEvent::Leave)
+            return false;
+
+        event.pos = QPoint(x, y);
+        events.append(event);
+    }
+
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    m_WindowSize = QSize(width, height);
+    m_Events = events;
+
+    return true;
+}
+
+
+OfficeInputRecorder::OfficeInputRecorder(QObject* parent)
+    : QObject(parent)
+    , m_Last(0)
+{
+}
+
+
+void
+OfficeInputRecorder::start(OfficeWindow* window)
+{
+    stop();
+
+    m_Recording = OfficeInputRecording();
+    m_Recording.setWindowSize(window->size());
+    m_Origin = window->geometry().topLeft();
+    m_Last = 0;
+
+    m_Target = nativeWindow(window);
+    m_Target->installEventFilter(this);
+    m_Timer.start();
+}
+
+
+void
+OfficeInputRecorder::stop()
+{
+    if (!m_Target.isNull())
+        m_Target->removeEventFilter(this);
+
+    m_Target.clear();
+}
+
+
+const OfficeInputRecording&
+OfficeInputRecorder::recording() const
+{
+    return m_Recording;
+}
+
+
+bool
+OfficeInputRecorder::eventFilter(QObject* watched, QEvent* event)
+{
+    if (watched != m_Target)
+        return false;
+
+    OfficeInputEvent input;
+    input.button = 0;
+    input.buttons = 0;
+    input.modifiers = 0;
+
+    switch (event->type())
+    {
+    case QEvent::MouseMove:             input.type = OfficeInputEvent::Move; break;
+    case QEvent::MouseButtonPress:      input.type = OfficeInputEvent::Press; break;
+    case QEvent::MouseButtonRelease:    input.type = OfficeInputEvent::Release; break;
+    case QEvent::MouseButtonDblClick:   input.type = OfficeInputEvent::DoubleClick; break;
+    case QEvent::Leave:                 input.type = OfficeInputEvent::Leave; break;
+    default:                            return false;
+    }
+
+    if (input.type != OfficeInputEvent::Leave)
+    {
+        auto* mouse = static_cast<QMouseEvent*>(event);
+        input.button = static_cast<quint8>(mouse->button());
+        input.buttons = static_cast<quint8>(int(mouse->buttons()));
+        input.modifiers = static_cast<quint8>(int(mouse->modifiers()) >> MODIFIER_SHIFT);
+        input.pos = mouse->globalPos() - m_Origin;
+    }
+
+    // Stores the delay to the previous event in microseconds.
+    const qint64 now = m_Timer.nsecsElapsed() / 1000;
+    input.delay = static_cast<quint32>(qMin(now - m_Last, qint64(0xFFFFFFFF)));
+    m_Last = now;
+
+    m_Recording.append(input);
+    return false;
+}
+
+
+OfficeReplayResult
+OfficeInputReplayer::replay(
+        const OfficeInputRecording& recording,
+        OfficeWindow* window,
+        bool realTime)
+{
+    static const QEvent::Type types[] =
+    {
+        QEvent::MouseMove,
+        QEvent::MouseButtonPress,
+        QEvent::MouseButtonRelease,
+        QEvent::MouseButtonDblClick,
+        QEvent::Leave
+    };
+
+    OfficeReplayResult result;
+    window->resize(recording.windowSize());
+    window->show();
+
+    // Starts with a window that has been laid out and painted.
+    QWindow* target = nativeWindow(window);
+    QCoreApplication::sendPostedEvents();
+
+    const QPoint origin = window->geometry().topLeft();
+    QElapsedTimer clock;
+    QElapsedTimer timer;
+    qint64 due = 0;
+
+    clock.start();
+    for (const auto& input : recording.events())
+    {
+        due += qint64(input.delay) * 1000;
+        if (realTime)
+            waitUntil(clock, due);
+
+        QScopedPointer<QEvent> event;
+        if (input.type == OfficeInputEvent::Leave)
+        {
+            event.reset(new QEvent(QEvent::Leave));
+        }
+        else
+        {
+            // The window might have been moved by a previous event.
+            const QPoint global = origin + input.pos;
+            const QPoint local = target->mapFromGlobal(global);
+
+            event.reset(new QMouseEvent(
+                    types[input.type],
+                    local,
+                    local,
+                    global,
+                    static_cast<Qt::MouseButton>(input.button),
+                    Qt::MouseButtons(QFlag(input.buttons)),
+                    Qt::KeyboardModifiers(QFlag(input.modifiers << MODIFIER_SHIFT))));
+        }
+
+        timer.start();
+        QCoreApplication::sendEvent(target, event.data());
+        result.events.add(timer.nsecsElapsed());
+
+        // Delivers the update request, which paints the frame.
+        const qint64 paints = OfficeCounters::value("window.paints");
+        timer.start();
+        QCoreApplication::sendPostedEvents();
+        const qint64 elapsed = timer.nsecsElapsed();
+
+        if (OfficeCounters::value("window.paints") != paints)
+            result.frames.add(elapsed);
+    }
+
+    result.duration = clock.nsecsElapsed();
+    return result;
+}
@@ -0,0 +1,293 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICEINPUTRECORDER_HPP
+#define QOFFICE_OFFICEINPUTRECORDER_HPP
+
+
+// QOffice headers
+#include <QOffice/Diagnostics/OfficeLatencyStats.hpp>
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPoint>
+#include <QPointer>
+#include <QSize>
+#include <QVector>
+
+// Forward declarations
+class QIODevice;
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+// Forward declarations
+class OfficeWindow;
+
+
+/**
+ * Holds a single recorded mouse event. Positions are global
+ * and relative to the position of the window when the
+ * recording was started.
+ *
+ * @struct OfficeInputEvent
+ * @author Nicolas Kogler
+ * @date January 14th, 2017
+ *
+ */
+struct OfficeInputEvent
+{
+    /**
+     * Holds all event types that can be recorded.
+     *
+     * @enum Type
+     *
+     */
+    enum Type
+    {
+        Move,
+        Press,
+        Release,
+        DoubleClick,
+        Leave
+    };
+
+    quint32 delay;      ///< Time since the previous event, in microseconds
+    quint8 type;        ///< The event type
+    quint8 button;      ///< The button that caused the event
+    quint8 buttons;     ///< The buttons held during the event
+    quint8 modifiers;   ///< The keyboard modifiers, shifted to the lowest byte
+    QPoint pos;         ///< The position relative to the initial window position
+};
+
+
+/**
+ * Holds a recorded input session and stores it in a compact
+ * binary format of 12 bytes per event.
+ *
+ * @class OfficeInputRecording
+ * @author Nicolas Kogler
+ * @date January 14th, 2017
+ *
+ */
+class OfficeInputRecording
+{
+public:
+
+    /**
+     * Retrieves the size of the window at the
+     * start of the recording.
+     *
+     * @returns the initial window size.
+     *
+     */
+    QSize windowSize() const;
+
+    /**
+     * Retrieves all recorded events in chronological order.
+     *
+     * @returns the recorded events.
+     *
+     */
+    const QVector<OfficeInputEvent>& events() const;
+
+    /**
+     * Specifies the size of the window at the
+     * start of the recording.
+     *
+     * @param size The initial window size.
+     *
+     */
+    void setWindowSize(const QSize& size);
+
+    /**
+     * Appends the given event to the recording.
+     *
+     * @param event The event to append.
+     *
+     */
+    void append(const OfficeInputEvent& event);
+
+
+    /**
+     * Writes the recording to the given device.
+     *
+     * @param device The device to write to.
+     * @returns false if the device could not be written.
+     *
+     */
+    bool save(QIODevice* device) const;
+
+    /**
+     * Reads a recording from the given device.
+     *
+     * @param device The device to read from.
+     * @returns false if the data is not a valid recording.
+     *
+     */
+    bool load(QIODevice* device);
+
+
+private:
+
+    // Members
+    QSize m_WindowSize;
+    QVector<OfficeInputEvent> m_Events;
+};
+
+
+/**
+ * Records the mouse input of an OfficeWindow, including the
+ * input on the caption buttons and the resize zones. Listens
+ * on the native window, therefore every event is recorded
+ * exactly once, before it is dispatched to the widgets.
+ *
+ * @class OfficeInputRecorder
+ * @author Nicolas Kogler
+ * @date January 14th, 2017
+ *
+ */
+class OfficeInputRecorder : public QObject
+{
+public:
+
+    /**
+     * Constructs a new, idle recorder.
+     *
+     * @param parent The parent of the recorder.
+     *
+     */
+    OfficeInputRecorder(QObject* parent = nullptr);
+
+
+    /**
+     * Starts recording the input of the given window.
+     * Discards the previous recording.
+     *
+     * @param window The window to record.
+     *
+     */
+    void start(OfficeWindow* window);
+
+    /**
+     * Stops recording.
+     *
+     */
+    void stop();
+
+    /**
+     * Retrieves the events recorded so far.
+     *
+     * @returns the recording.
+     *
+     */
+    const OfficeInputRecording& recording() const;
+
+
+protected:
+
+    /**
+     * Records the mouse events of the native window.
+     *
+     */
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+
+private:
+
+    // Members
+    QPointer<QObject> m_Target;
+    OfficeInputRecording m_Recording;
+    QElapsedTimer m_Timer;
+    QPoint m_Origin;
+    qint64 m_Last;
+};
+
+
+/**
+ * Holds the latencies collected while replaying.
+ *
+ * @struct OfficeReplayResult
+ * @author Nicolas Kogler
+ * @date January 14th, 2017
+ *
+ */
+struct OfficeReplayResult
+{
+    OfficeLatencyStats events;  ///< Time spent handling each event
+    OfficeLatencyStats frames;  ///< Time spent on each resulting repaint
+    qint64 duration = 0;        ///< Total replay time, in nanoseconds
+};
+
+
+/**
+ * Replays a recording on an OfficeWindow and measures the
+ * latency of every event and every frame it causes. Run
+ * the application with QT_QPA_PLATFORM=offscreen to replay
+ * without a display, e.g. on a build server.
+ *
+ * @class OfficeInputReplayer
+ * @author Nicolas Kogler
+ * @date January 14th, 2017
+ *
+ */
+class OfficeInputReplayer
+{
+public:
+
+    /**
+     * Replays the given recording on the given window. The
+     * window is resized to the recorded size beforehand.
+     *
+     * @param recording The recording to replay.
+     * @param window The window to replay on.
+     * @param realTime False to ignore the recorded timing.
+     * @returns the collected latencies.
+     *
+     */
+    static OfficeReplayResult replay(
+            const OfficeInputRecording& recording,
+            OfficeWindow* window,
+            bool realTime = true);
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     OfficeInputRecording recording;
+ *     recording.load(&file);
+ *
+ *     auto result = OfficeInputReplayer::replay(recording, window);
+ *     qint64 p99 = result.frames.percentile(0.99);
+ * @endcode
+ *
+ */
+
+#endif // QOFFICE_OFFICEINPUTRECORDER_HPP
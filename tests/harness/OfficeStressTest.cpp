@@ -0,0 +1,299 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include "OfficeStressTest.hpp"
+#include <QOffice/Diagnostics/OfficeCounters.hpp>
+#include <QOffice/Diagnostics/OfficeMemory.hpp>
+#include <QOffice/Widgets/OfficeWindow.hpp>
+#include <QOffice/Widgets/Constants/OfficeWindowConstants.hpp>
+
+// Qt headers
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QMouseEvent>
+#include <QWindow>
+
+// Standard headers
+#include <random>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+#define STRESS_MAX_MESSAGES     32      ///< Number of violations to describe
+#define STRESS_MEMORY_INTERVAL  1024    ///< Steps between two memory samples
+
+
+/**
+ * Holds the observable state of the window frame.
+ *
+ */
+struct OfficeStressTest::Snapshot
+{
+    int hot;
+    WinButtonState caption;
+    WindowState state;
+    QRect geometry;
+    bool maximized;
+    IOfficeWidget::Accent accent;
+
+    bool operator ==(const Snapshot& other) const
+    {
+        return hot == other.hot &&
+               caption == other.caption &&
+               state == other.state &&
+               geometry == other.geometry &&
+               maximized == other.maximized &&
+               accent == other.accent;
+    }
+};
+
+
+/**
+ * Holds all steps the stress test can perform.
+ *
+ */
+enum class StressAction
+{
+    Move,
+    Press,
+    Release,
+    DoubleClick,
+    Leave,
+    Resize,
+    Maximize,
+    Accent
+};
+
+
+/**
+ * Picks a point that is likely to hit the caption
+ * buttons, the drag area or the resize zones.
+ *
+ */
+static QPoint randomPoint(std::mt19937& rng, const QSize& size)
+{
+    std::uniform_int_distribution<int> zone(0, 99);
+    std::uniform_int_distribution<int> x(-5, size.width() + 5);
+    std::uniform_int_distribution<int> y(-5, size.height() + 5);
+    std::uniform_int_distribution<int> title(0, DROP_SHADOW_PADDING + TITLE_HEIGHT + 5);
+    std::uniform_int_distribution<int> edge(0, 10);
+
+    const int pick = zone(rng);
+    if (pick < 50)
+        return QPoint(x(rng), title(rng));
+    if (pick < 65)
+        return QPoint(size.width() - edge(rng), y(rng));
+    if (pick < 75)
+        return QPoint(x(rng), size.height() - edge(rng));
+
+    return QPoint(x(rng), y(rng));
+}
+
+
+/**
+ * Picks the next action, weighted by how often
+ * it occurs in a real session.
+ *
+ */
+static StressAction randomAction(std::mt19937& rng)
+{
+    static std::discrete_distribution<int> action({ 55, 12, 12, 3, 3, 8, 3, 4 });
+    return static_cast<StressAction>(action(rng));
+}
+
+
+/**
+ * Sends a synthesized mouse event to the native window,
+ * which dispatches it like a real one.
+ *
+ */
+static void sendMouse(
+        OfficeWindow* window,
+        QEvent::Type type,
+        const QPoint& local,
+        Qt::MouseButton button,
+        Qt::MouseButtons buttons)
+{
+    QMouseEvent event(
+            type,
+            local,
+            local,
+            window->mapToGlobal(local),
+            button,
+            buttons,
+            Qt::NoModifier);
+
+    QCoreApplication::sendEvent(window->windowHandle(), &event);
+}
+
+
+OfficeStressResult
+OfficeStressTest::run(OfficeWindow* window, quint64 steps, quint32 seed)
+{
+    OfficeStressResult result;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dimension(200, 1200);
+    std::uniform_int_distribution<int> accent(IOfficeWidget::Blue, IOfficeWidget::Purple);
+
+    // Observes the paints through the counter registry.
+    OfficeCounter* paints = nullptr;
+    for (auto* counter : OfficeCounters::all())
+    {
+        if (qstrcmp(counter->name(), "window.paints") == 0)
+            paints = counter;
+    }
+
+    window->show();
+    window->winId();
+    QCoreApplication::sendPostedEvents();
+
+    Qt::MouseButtons held = Qt::NoButton;
+    QPoint cursor;
+    QElapsedTimer timer;
+
+    for (quint64 step = 0; step < steps; ++step)
+    {
+        const Snapshot before = capture(window);
+        const qint64 paintsBefore = (paints != nullptr) ? paints->value() : 0;
+        const StressAction action = randomAction(rng);
+
+        timer.start();
+        switch (action)
+        {
+        case StressAction::Move:
+            cursor = randomPoint(rng, window->size());
+            sendMouse(window, QEvent::MouseMove, cursor, Qt::NoButton, held);
+            break;
+        case StressAction::Press:
+            held |= Qt::LeftButton;
+            sendMouse(window, QEvent::MouseButtonPress, cursor, Qt::LeftButton, held);
+            break;
+        case StressAction::Release:
+            held &= ~Qt::LeftButton;
+            sendMouse(window, QEvent::MouseButtonRelease, cursor, Qt::LeftButton, held);
+            break;
+        case StressAction::DoubleClick:
+            sendMouse(window, QEvent::MouseButtonDblClick, cursor, Qt::LeftButton, held | Qt::LeftButton);
+            break;
+        case StressAction::Leave:
+        {
+            QEvent leave(QEvent::Leave);
+            QCoreApplication::sendEvent(window->windowHandle(), &leave);
+            break;
+        }
+        case StressAction::Resize:
+            window->resize(dimension(rng), dimension(rng));
+            break;
+        case StressAction::Maximize:
+            if (window->isMaximized())
+                window->showNormal();
+            else
+                window->showMaximized();
+            break;
+        case StressAction::Accent:
+            window->setAccent(static_cast<IOfficeWidget::Accent>(accent(rng)));
+            break;
+        }
+
+        QCoreApplication::sendPostedEvents();
+        result.latency.add(timer.nsecsElapsed());
+        result.steps++;
+
+        // Checks the invariants of the frame state machines.
+        const bool painted = (paints != nullptr) && paints->value() != paintsBefore;
+        for (const QString& violation : check(window, before, held != Qt::NoButton, painted))
+        {
+            result.violations[violation]++;
+            if (result.messages.size() < STRESS_MAX_MESSAGES)
+                result.messages.append(QString("step %1: %2").arg(step).arg(violation));
+        }
+
+        // Brings back windows that were closed or minimized.
+        if (!window->isVisible() || window->isMinimized())
+        {
+            held = Qt::NoButton;
+            window->showNormal();
+            QCoreApplication::sendPostedEvents();
+        }
+
+        if (step % STRESS_MEMORY_INTERVAL == 0 || step + 1 == steps)
+        {
+            const qint64 memory = OfficeMemory::usage().total();
+            if (step == 0)
+                result.memoryStart = memory;
+
+            result.memoryEnd = memory;
+            result.memoryPeak = qMax(result.memoryPeak, memory);
+        }
+    }
+
+    return result;
+}
+
+
+OfficeStressTest::Snapshot
+OfficeStressTest::capture(const OfficeWindow* window)
+{
+    Snapshot snapshot;
+    const WinFrameState frame = window->frameState();
+    snapshot.hot = frame.hotItem;
+    snapshot.caption = frame.hotState;
+    snapshot.state = frame.interaction;
+    snapshot.geometry = window->geometry();
+    snapshot.maximized = window->isMaximized();
+    snapshot.accent = window->accent();
+
+    return snapshot;
+}
+
+
+QStringList
+OfficeStressTest::check(
+        const OfficeWindow* window,
+        const Snapshot& before,
+        bool held,
+        bool painted)
+{
+    QStringList violations;
+    const Snapshot after = capture(window);
+
+    // All caption items share one state, therefore at most
+    // one of them can be active at any time.
+    const bool active = after.caption != WinButtonState::None;
+    const bool pressed = after.caption >= WinButtonState::Pressed;
+
+    if (active != (after.hot >= 0))
+        violations.append("caption state without caption item");
+    if (after.hot >= 0 && (!window->isCaptionItemVisible(after.hot) ||
+                           window->captionWidget(after.hot) != nullptr))
+        violations.append("hidden caption button active");
+    if (!held && pressed)
+        violations.append("caption button pressed without mouse button");
+    if (!held && after.state != WindowState::None)
+        violations.append("window dragged or resized without mouse button");
+    if (painted && after == before)
+        violations.append("paint without state change");
+
+    return violations;
+}
@@ -0,0 +1,136 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef QOFFICE_OFFICESTRESSTEST_HPP
+#define QOFFICE_OFFICESTRESSTEST_HPP
+
+
+// QOffice headers
+#include <QOffice/Diagnostics/OfficeLatencyStats.hpp>
+
+// Qt headers
+#include <QMap>
+#include <QStringList>
+
+
+QOFFICE_BEGIN_NAMESPACE
+
+
+// Forward declarations
+class OfficeWindow;
+
+
+/**
+ * Holds the outcome of a stress test run.
+ *
+ * @struct OfficeStressResult
+ * @author Nicolas Kogler
+ * @date January 15th, 2017
+ *
+ */
+struct OfficeStressResult
+{
+    quint64 steps = 0;                  ///< Number of performed steps
+    QMap<QString, quint64> violations;  ///< Violations per invariant
+    QStringList messages;               ///< Details of the first violations
+    OfficeLatencyStats latency;         ///< Handling time of every step
+    qint64 memoryStart = 0;             ///< Cache memory after the first step
+    qint64 memoryEnd = 0;               ///< Cache memory after the last step
+    qint64 memoryPeak = 0;              ///< Highest sampled cache memory
+
+    /**
+     * Determines whether no invariant was violated.
+     *
+     * @returns true if the run passed.
+     *
+     */
+    bool passed() const { return violations.isEmpty(); }
+};
+
+
+/**
+ * Drives an OfficeWindow with long, reproducible sequences of
+ * random presses, moves, releases, double clicks, resizes,
+ * maximizations and accent changes. The state of the window
+ * frame is checked against its invariants after every step:
+ *
+ * - a caption state always belongs to a caption item
+ * - hidden caption buttons are never hovered or pressed
+ * - buttons are only pressed while the mouse button is held
+ * - dragging and resizing only while the mouse button is held
+ * - the window is only repainted if its state has changed
+ *
+ * A window that gets closed or minimized is shown again.
+ *
+ * @class OfficeStressTest
+ * @author Nicolas Kogler
+ * @date January 15th, 2017
+ *
+ */
+class OfficeStressTest
+{
+public:
+
+    /**
+     * Runs the given number of random steps on the window.
+     *
+     * @param window The window to stress.
+     * @param steps The number of steps to perform.
+     * @param seed The seed of the step sequence.
+     * @returns the violations, latencies and memory growth.
+     *
+     */
+    static OfficeStressResult run(
+            OfficeWindow* window,
+            quint64 steps,
+            quint32 seed = 0);
+
+
+private:
+
+    // Helpers
+    struct Snapshot;
+    static Snapshot capture(const OfficeWindow* window);
+    static QStringList check(
+            const OfficeWindow* window,
+            const Snapshot& before,
+            bool held,
+            bool painted);
+};
+
+
+QOFFICE_END_NAMESPACE
+
+
+/**
+ * @ingroup Base
+ *
+ * Usage example:
+ * @code
+ *     auto result = OfficeStressTest::run(window, 1000000, 42);
+ *     if (!result.passed())
+ *         qWarning() << result.messages;
+ * @endcode
+ *
+ */
+
+#endif // QOFFICE_OFFICESTRESSTEST_HPP
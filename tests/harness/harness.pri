@@ -0,0 +1,29 @@
+###########################################################
+#
+#   QOffice: Office UI framework for Qt
+#   Copyright (C) 2016-2017 Nicolas Kogler
+#   License: Lesser General Public License 3.0
+#
+###########################################################
+
+###########################################################
+#
+# INCLUDE PATHS
+###########################################################
+INCLUDEPATH         +=      $$PWD
+
+###########################################################
+#
+# HEADER FILES
+###########################################################
+HEADERS             +=      $$PWD/OfficeIdleProbe.hpp \
+                            $$PWD/OfficeInputRecorder.hpp \
+                            $$PWD/OfficeStressTest.hpp
+
+###########################################################
+#
+# SOURCE FILES
+###########################################################
+SOURCES             +=      $$PWD/OfficeIdleProbe.cpp \
+                            $$PWD/OfficeInputRecorder.cpp \
+                            $$PWD/OfficeStressTest.cpp
@@ -0,0 +1,33 @@
+###########################################################
+#
+#   QOffice: Office UI framework for Qt
+#   Copyright (C) 2016-2017 Nicolas Kogler
+#   License: Lesser General Public License 3.0
+#
+###########################################################
+
+###########################################################
+#
+# QMAKE SETTINGS
+#
+# Links a test or benchmark against the runtime library
+# built next to it.
+###########################################################
+include(../QOffice.pri)
+
+###########################################################
+#
+# LIBRARIES
+###########################################################
+LIBRARY_DIR     =       $$OUT_PWD/../..
+
+win32:CONFIG(release, debug|release) {
+    LIBS            +=      -L$$LIBRARY_DIR/release
+} else:win32:CONFIG(debug, debug|release) {
+    LIBS            +=      -L$$LIBRARY_DIR/debug
+} else {
+    LIBS            +=      -L$$LIBRARY_DIR
+    QMAKE_RPATHDIR  +=      $$LIBRARY_DIR
+}
+
+LIBS                +=      -lQOffice
@@ -0,0 +1,113 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Diagnostics/OfficeLatencyStats.hpp>
+
+// Qt headers
+#include <QApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QPluginLoader>
+#include <QtUiPlugin/QDesignerCustomWidgetCollectionInterface>
+
+
+QOFFICE_USING_NAMESPACE
+
+
+#define BENCH_PASSES    1000    ///< Default number of widget box populations
+
+
+/**
+ * Queries everything the widget box of Qt Designer queries
+ * for each plugin when it is populated.
+ *
+ */
+static int populate(const QList<QDesignerCustomWidgetInterface*>& plugins)
+{
+    int size = 0;
+    for (auto* plugin : plugins)
+    {
+        size += plugin->name().size();
+        size += plugin->group().size();
+        size += plugin->includeFile().size();
+        size += plugin->toolTip().size();
+        size += plugin->domXml().size();
+        size += plugin->icon().isNull() ? 0 : 1;
+        size += plugin->isContainer() ? 1 : 0;
+    }
+
+    return size;
+}
+
+
+int main(int argc, char* argv[])
+{
+    QApplication app(argc, argv);
+
+    // Accepts the number of populations as optional argument.
+    int passes = (argc > 1) ? QByteArray(argv[1]).toInt() : BENCH_PASSES;
+    if (passes <= 0)
+        passes = BENCH_PASSES;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QPluginLoader loader(QDir(QOFFICE_PLUGIN_DIR).filePath("QOfficeDesigner"));
+    auto* collection = qobject_cast<QDesignerCustomWidgetCollectionInterface*>(loader.instance());
+    if (collection == nullptr)
+    {
+        qWarning("plugins: %s", qPrintable(loader.errorString()));
+        return 1;
+    }
+
+    const qint64 loaded = timer.nsecsElapsed();
+
+    // The collection is the first thing Designer queries.
+    timer.start();
+    const QList<QDesignerCustomWidgetInterface*> plugins = collection->customWidgets();
+    const qint64 created = timer.nsecsElapsed();
+
+    // The first population reads the XML and decodes the icons.
+    timer.start();
+    int size = populate(plugins);
+    const qint64 first = timer.nsecsElapsed();
+
+    OfficeLatencyStats repeated;
+    for (int i = 0; i < passes; ++i)
+    {
+        timer.start();
+        size += populate(plugins);
+        repeated.add(timer.nsecsElapsed());
+    }
+
+    qInfo("plugins: %d widgets, %d populations (checksum %d)", plugins.size(), passes, size);
+    qInfo("  load and instantiate the collection: %lld us", loaded / 1000);
+    qInfo("  customWidgets(): %lld us", created / 1000);
+    qInfo("  first population: %lld us", first / 1000);
+    qInfo("  repeated population: mean %lld ns, p99 %lld ns, max %lld ns",
+          repeated.mean(),
+          repeated.percentile(0.99),
+          repeated.max());
+
+    return 0;
+}
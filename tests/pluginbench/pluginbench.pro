@@ -0,0 +1,36 @@
+###########################################################
+#
+#   QOffice: Office UI framework for Qt
+#   Copyright (C) 2016-2017 Nicolas Kogler
+#   License: Lesser General Public License 3.0
+#
+###########################################################
+
+###########################################################
+#
+# QMAKE SETTINGS
+#
+# Loads the Qt Designer plugin built next to the runtime
+# library. Runs without a display if QT_QPA_PLATFORM=offscreen.
+###########################################################
+TARGET          =       QOfficePluginBench
+TEMPLATE        =       app
+QT             +=       widgets uiplugin
+CONFIG         +=       console
+CONFIG         -=       app_bundle
+
+include(../library.pri)
+
+win32:CONFIG(release, debug|release) {
+    DEFINES         +=      QOFFICE_PLUGIN_DIR=\\\"$$LIBRARY_DIR/release\\\"
+} else:win32:CONFIG(debug, debug|release) {
+    DEFINES         +=      QOFFICE_PLUGIN_DIR=\\\"$$LIBRARY_DIR/debug\\\"
+} else {
+    DEFINES         +=      QOFFICE_PLUGIN_DIR=\\\"$$LIBRARY_DIR\\\"
+}
+
+###########################################################
+#
+# SOURCE FILES
+###########################################################
+SOURCES             +=      main.cpp
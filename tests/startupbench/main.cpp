@@ -0,0 +1,237 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Widgets/OfficeWindow.hpp>
+#include <QOffice/Widgets/Constants/OfficeWindowConstants.hpp>
+#include <QOffice/Design/OfficeGlyphs.hpp>
+#include <QOffice/Diagnostics/OfficeStartupTrace.hpp>
+
+// Qt headers
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QProcess>
+#include <QVector>
+
+// Standard headers
+#include <algorithm>
+#include <cstdio>
+
+// Platform headers
+#if defined(Q_OS_UNIX)
+    #include <unistd.h>
+#endif
+
+
+QOFFICE_USING_NAMESPACE
+
+
+#define BENCH_RUNS      20      ///< Default number of measured processes
+#define BENCH_TIMEOUT   10000   ///< Maximum time to the first paint, in milliseconds
+#define BENCH_WIDTH     480     ///< Width of the first window
+#define BENCH_HEIGHT    320     ///< Height of the first window
+
+
+/**
+ * Retrieves the resident memory of the process in bytes,
+ * or -1 if the platform does not expose it cheaply.
+ *
+ */
+static qint64 residentMemory()
+{
+#if defined(Q_OS_LINUX)
+    QFile file("/proc/self/statm");
+    if (!file.open(QFile::ReadOnly))
+        return -1;
+
+    const QList<QByteArray> fields = file.readAll().split(' ');
+    if (fields.size() < 2)
+        return -1;
+
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+    return -1;
+#endif
+}
+
+
+/**
+ * Determines whether the Qt Designer libraries have been
+ * loaded into the process, which the runtime library must
+ * not cause. Is always false if it cannot be determined.
+ *
+ */
+static bool designerLoaded()
+{
+#if defined(Q_OS_LINUX)
+    QFile maps("/proc/self/maps");
+    if (!maps.open(QFile::ReadOnly))
+        return false;
+
+    const QByteArray content = maps.readAll();
+    return content.contains("Qt5Designer") || content.contains("Qt5UiTools");
+#else
+    return false;
+#endif
+}
+
+
+/**
+ * Rasterizes all window glyphs once, bypassing the cache,
+ * which is what the first window of a screen has to do.
+ *
+ * @returns the time it took in microseconds.
+ *
+ */
+static qint64 rasterizeGlyphs(qreal dpr)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < OfficeGlyphs::Max; ++i)
+    {
+        OfficeGlyphs::render(
+                    static_cast<OfficeGlyphs::Glyph>(i),
+                    QSize(WINDOW_GLYPH_SIZE, WINDOW_GLYPH_SIZE),
+                    dpr,
+                    Qt::black);
+    }
+
+    return timer.nsecsElapsed() / 1000;
+}
+
+
+/**
+ * Starts the application, shows the first window and
+ * prints the startup phases once it has been painted.
+ * Each measurement needs a process of its own, as only
+ * the first startup of a process is of interest.
+ *
+ */
+static int measure(int argc, char* argv[])
+{
+    QApplication app(argc, argv);
+    OfficeWindow window;
+    window.resize(BENCH_WIDTH, BENCH_HEIGHT);
+    window.show();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (OfficeStartupTrace::elapsed(OfficeStartupTrace::FirstPaint) < 0)
+    {
+        if (timer.elapsed() > BENCH_TIMEOUT)
+            return 1;
+
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+
+    for (int i = 0; i < OfficeStartupTrace::Max; ++i)
+        std::printf("%lld ", OfficeStartupTrace::elapsed(static_cast<OfficeStartupTrace::Phase>(i)));
+
+    // Measured after the first paint, so the phases stay unaffected.
+    std::printf("%lld %d %lld\n",
+                residentMemory(),
+                designerLoaded() ? 1 : 0,
+                rasterizeGlyphs(window.devicePixelRatioF()));
+    return 0;
+}
+
+
+/**
+ * Retrieves the median of the given samples.
+ *
+ */
+static qint64 median(QVector<qint64> samples)
+{
+    if (samples.isEmpty())
+        return -1;
+
+    std::sort(samples.begin(), samples.end());
+    return samples.at(samples.size() / 2);
+}
+
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && qstrcmp(argv[1], "--measure") == 0)
+        return measure(argc, argv);
+
+    QCoreApplication app(argc, argv);
+
+    // Accepts the number of processes as optional argument.
+    int runs = (argc > 1) ? QByteArray(argv[1]).toInt() : BENCH_RUNS;
+    if (runs <= 0)
+        runs = BENCH_RUNS;
+
+    QVector<QVector<qint64>> phases(OfficeStartupTrace::Max);
+    QVector<qint64> resident;
+    QVector<qint64> glyphs;
+    bool designer = false;
+
+    for (int run = 0; run < runs; ++run)
+    {
+        QProcess process;
+        process.start(QCoreApplication::applicationFilePath(), QStringList("--measure"));
+
+        if (!process.waitForFinished(BENCH_TIMEOUT * 2) || process.exitCode() != 0)
+        {
+            qWarning("startup: run %d did not paint its first window", run);
+            return 1;
+        }
+
+        const QList<QByteArray> fields = process.readAllStandardOutput().trimmed().split(' ');
+        if (fields.size() != OfficeStartupTrace::Max + 3)
+        {
+            qWarning("startup: run %d reported malformed phases", run);
+            return 1;
+        }
+
+        for (int i = 0; i < OfficeStartupTrace::Max; ++i)
+        {
+            if (fields.at(i).toLongLong() >= 0)
+                phases[i].append(fields.at(i).toLongLong());
+        }
+
+        resident.append(fields.at(OfficeStartupTrace::Max).toLongLong());
+        designer |= fields.at(OfficeStartupTrace::Max + 1).toInt() != 0;
+        glyphs.append(fields.at(OfficeStartupTrace::Max + 2).toLongLong());
+    }
+
+    // Medians are robust against the outliers of cold caches.
+    qInfo("startup: median of %d processes, from the start of the process", runs);
+    for (int i = 0; i < OfficeStartupTrace::Max; ++i)
+    {
+        const char* name = OfficeStartupTrace::name(static_cast<OfficeStartupTrace::Phase>(i));
+        if (phases.at(i).isEmpty())
+            qInfo("  %s: not reached", name);
+        else
+            qInfo("  %s: %.3f ms", name, median(phases.at(i)) / 1000.0);
+    }
+
+    qInfo("  glyph rasterization of the first window: %.3f ms", median(glyphs) / 1000.0);
+    qInfo("  resident memory after the first paint: %lld bytes", median(resident));
+    qInfo("  designer libraries loaded: %s", designer ? "yes" : "no");
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+###########################################################
+#
+#   QOffice: Office UI framework for Qt
+#   Copyright (C) 2016-2017 Nicolas Kogler
+#   License: Lesser General Public License 3.0
+#
+###########################################################
+
+###########################################################
+#
+# QMAKE SETTINGS
+#
+# Runs without a display if QT_QPA_PLATFORM=offscreen.
+###########################################################
+TARGET          =       QOfficeStartupBench
+TEMPLATE        =       app
+QT             +=       widgets
+CONFIG         +=       console
+CONFIG         -=       app_bundle
+
+include(../library.pri)
+
+###########################################################
+#
+# SOURCE FILES
+###########################################################
+SOURCES             +=      main.cpp
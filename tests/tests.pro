@@ -0,0 +1,29 @@
+###########################################################
+#
+#   QOffice: Office UI framework for Qt
+#   Copyright (C) 2016-2017 Nicolas Kogler
+#   License: Lesser General Public License 3.0
+#
+###########################################################
+
+###########################################################
+#
+# QMAKE SETTINGS
+#
+# The test harnesses are compiled into the tests only,
+# so they never become part of the runtime library. The
+# benchmarks are built along with the tests, but are not
+# run by 'make check', as they only report measurements.
+###########################################################
+TEMPLATE        =       subdirs
+SUBDIRS        +=       frametest \
+                        startupbench \
+                        windowbench
+
+# The Qt Designer plugin is not built statically.
+!qoffice_static {
+    SUBDIRS    +=       pluginbench
+}
+
+OTHER_FILES    +=       library.pri \
+                        harness/harness.pri
@@ -0,0 +1,176 @@
+/*
+ *  QOffice: Office UI framework for Qt
+ *  Copyright (C) 2016-2017 Nicolas Kogler
+ *
+ *  This file is part of QOffice.
+ *
+ *  QOffice is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  QOffice is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// QOffice headers
+#include <QOffice/Widgets/OfficeDialog.hpp>
+#include <QOffice/Widgets/OfficeWindow.hpp>
+#include <QOffice/Diagnostics/OfficeCounters.hpp>
+#include <QOffice/Diagnostics/OfficeLatencyStats.hpp>
+#include <QOffice/Diagnostics/OfficeMemory.hpp>
+
+// Qt headers
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+
+// Standard headers
+#include <functional>
+
+// Platform headers
+#if defined(Q_OS_UNIX)
+    #include <unistd.h>
+#endif
+
+
+QOFFICE_USING_NAMESPACE
+
+
+#define BENCH_WINDOWS   500     ///< Default number of windows per run
+#define BENCH_WIDTH     480     ///< Width of the benchmarked windows
+#define BENCH_HEIGHT    320     ///< Height of the benchmarked windows
+
+
+/**
+ * Retrieves the resident memory of the process in bytes,
+ * or -1 if the platform does not expose it cheaply.
+ *
+ */
+static qint64 residentMemory()
+{
+#if defined(Q_OS_LINUX)
+    QFile file("/proc/self/statm");
+    if (!file.open(QFile::ReadOnly))
+        return -1;
+
+    const QList<QByteArray> fields = file.readAll().split(' ');
+    if (fields.size() < 2)
+        return -1;
+
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+    return -1;
+#endif
+}
+
+
+/**
+ * Holds the measurements of one benchmark run.
+ *
+ */
+struct BenchResult
+{
+    qint64 construction;
+    qint64 resident;
+    int children;
+};
+
+
+/**
+ * Opens the given number of windows built by the factory,
+ * and reports the time it takes to construct and to show
+ * them, as well as the memory and widgets they hold.
+ *
+ */
+static BenchResult benchmark(const char* name, int count, const std::function<OfficeWindow*()>& factory)
+{
+    QList<OfficeWindow*> windows;
+    OfficeLatencyStats construction;
+    QElapsedTimer timer;
+
+    const qint64 residentBefore = residentMemory();
+    const qint64 cachesBefore = OfficeMemory::usage().total();
+    const qint64 areasBefore = OfficeCounters::value("window.resizeAreas");
+
+    for (int i = 0; i < count; ++i)
+    {
+        timer.start();
+        OfficeWindow* window = factory();
+        construction.add(timer.nsecsElapsed());
+
+        window->resize(BENCH_WIDTH, BENCH_HEIGHT);
+        windows.append(window);
+    }
+
+    // Shows all windows and lets them paint their first frame.
+    timer.start();
+    for (auto* window : windows)
+        window->show();
+
+    QCoreApplication::processEvents();
+    const qint64 shown = timer.nsecsElapsed();
+
+    const qint64 resident = residentMemory() - residentBefore;
+    const qint64 caches = OfficeMemory::usage().total() - cachesBefore;
+    const qint64 areas = OfficeCounters::value("window.resizeAreas") - areasBefore;
+    const int children = windows.first()->findChildren<QWidget*>().size();
+
+    qInfo("%s: %d windows", name, count);
+    qInfo("  construction: mean %lld us, p99 %lld us, max %lld us",
+          construction.mean() / 1000,
+          construction.percentile(0.99) / 1000,
+          construction.max() / 1000);
+    qInfo("  show and first paint: %lld ms in total", shown / 1000000);
+    qInfo("  per window: %d child widgets, %lld resize areas, %lld bytes reported",
+          children,
+          areas / count,
+          windows.first()->memoryUsage().total());
+    qInfo("  shared caches: %lld bytes, resident memory: %lld bytes per window",
+          caches,
+          (resident < 0) ? -1 : resident / count);
+
+    qDeleteAll(windows);
+    QCoreApplication::processEvents();
+
+    BenchResult result;
+    result.construction = construction.mean();
+    result.resident = (resident < 0) ? -1 : resident / count;
+    result.children = children;
+
+    return result;
+}
+
+
+int main(int argc, char* argv[])
+{
+    QApplication app(argc, argv);
+
+    // Accepts the number of windows as optional argument.
+    int count = (argc > 1) ? QByteArray(argv[1]).toInt() : BENCH_WINDOWS;
+    if (count <= 0)
+        count = BENCH_WINDOWS;
+
+    // Both runs share the frame assets, which the first
+    // run has to rasterize, hence a warm-up run precedes.
+    benchmark("warm-up", 1, [] () { return new OfficeWindow; });
+    const BenchResult window = benchmark("OfficeWindow", count, [] () { return new OfficeWindow; });
+    const BenchResult dialog = benchmark("OfficeDialog", count, [] () { return new OfficeDialog; });
+
+    qInfo("OfficeDialog vs. OfficeWindow: construction %lld%%, child widgets %d vs. %d",
+          (window.construction > 0) ? dialog.construction * 100 / window.construction : 0,
+          dialog.children,
+          window.children);
+
+    if (window.resident >= 0)
+        qInfo("  resident memory per window: %lld vs. %lld bytes", dialog.resident, window.resident);
+
+    return 0;
+}